@@ -0,0 +1,139 @@
+#include <cstring>
+
+#include "s21_matrix_oop.h"
+
+// COMPARISON
+
+namespace {
+
+// Elements are checked in blocks without branches; the loop only exits
+// between blocks, which keeps the block body vectorizable.
+const int kCompareBlock = 16;
+
+std::uint64_t Bits(double value) {
+  std::uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Maps doubles onto integers whose order and distance follow the floating
+// point steps, so that |Ordered(a) - Ordered(b)| is the ULP distance.
+std::int64_t Ordered(double value) {
+  std::uint64_t bits = Bits(value);
+  return bits >> 63 ? static_cast<std::int64_t>(0x8000000000000000ULL - bits)
+                    : static_cast<std::int64_t>(bits);
+}
+
+bool Close(double a, double b, const S21Tolerance& tolerance) {
+  double diff = std::fabs(a - b);
+  if (diff < tolerance.absolute) return true;
+  if (diff <= tolerance.relative * std::fmax(std::fabs(a), std::fabs(b))) {
+    return true;
+  }
+  if (tolerance.ulps > 0 && !std::isnan(a) && !std::isnan(b)) {
+    std::int64_t x = Ordered(a), y = Ordered(b);
+    std::uint64_t distance = x > y ? std::uint64_t(x) - std::uint64_t(y)
+                                   : std::uint64_t(y) - std::uint64_t(x);
+    return distance <= std::uint64_t(tolerance.ulps);
+  }
+  return false;
+}
+
+template <class Mismatch>
+bool RowsMatch(double** a, double** b, int rows, int cols,
+               Mismatch mismatch) {
+  for (int i = 0; i < rows; ++i) {
+    const double* x = a[i];
+    const double* y = b[i];
+    int j = 0;
+    for (; j + kCompareBlock <= cols; j += kCompareBlock) {
+      bool any = false;
+      for (int t = 0; t < kCompareBlock; ++t) {
+        any |= mismatch(x[j + t], y[j + t]);
+      }
+      if (any) return false;
+    }
+    for (; j < cols; ++j) {
+      if (mismatch(x[j], y[j])) return false;
+    }
+  }
+  return true;
+}
+
+std::uint64_t Mix(std::uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+}  // namespace
+
+bool S21Matrix::all_close(const S21Matrix& other,
+                          const S21Tolerance& tolerance) const {
+  if (tolerance.relative == 0 && tolerance.ulps == 0) {
+    double absolute = tolerance.absolute;
+    return RowsMatch(matrix_, other.matrix_, rows_, cols_,
+                     [absolute](double a, double b) {
+                       return !(std::fabs(a - b) < absolute);
+                     });
+  }
+  return RowsMatch(matrix_, other.matrix_, rows_, cols_,
+                   [&tolerance](double a, double b) {
+                     return !Close(a, b, tolerance);
+                   });
+}
+
+bool S21Matrix::ApproxEqual(const S21Matrix& other,
+                            const S21Tolerance& tolerance) const {
+  if (IsInvalid() || other.IsInvalid() || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    return false;
+  }
+  return all_close(other, tolerance);
+}
+
+bool S21Matrix::ExactEqual(const S21Matrix& other) const {
+  if (IsInvalid() || other.IsInvalid() || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    return false;
+  }
+  std::uint64_t mine = fingerprint_.load(std::memory_order_relaxed);
+  std::uint64_t theirs = other.fingerprint_.load(std::memory_order_relaxed);
+  if (mine && theirs && mine != theirs) return false;
+  return RowsMatch(matrix_, other.matrix_, rows_, cols_,
+                   [](double a, double b) { return !(a == b); });
+}
+
+// Four independent lanes keep the multiplies pipelined; -0.0 is hashed as
+// 0.0 so that ExactEqual matrices always share a fingerprint.
+std::uint64_t S21Matrix::Fingerprint() const {
+  std::uint64_t cached = fingerprint_.load(std::memory_order_relaxed);
+  if (cached) return cached;
+  if (IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  const std::uint64_t kPrime = 0x9e3779b97f4a7c15ULL;
+  std::uint64_t lanes[4] = {Mix(rows_), Mix(cols_ + kPrime), kPrime, 0};
+  for (int i = 0; i < rows_; ++i) {
+    const double* row = matrix_[i];
+    int j = 0;
+    for (; j + 4 <= cols_; j += 4) {
+      for (int t = 0; t < 4; ++t) {
+        lanes[t] = (lanes[t] ^ Bits(row[j + t] + 0.0)) * kPrime;
+        lanes[t] ^= lanes[t] >> 29;
+      }
+    }
+    for (; j < cols_; ++j) {
+      lanes[0] = (lanes[0] ^ Bits(row[j] + 0.0)) * kPrime;
+      lanes[0] ^= lanes[0] >> 29;
+    }
+  }
+  std::uint64_t hash = Mix(lanes[0] ^ Mix(lanes[1] ^ Mix(lanes[2] ^
+                                                         Mix(lanes[3]))));
+  if (hash == 0) hash = 1;
+  fingerprint_.store(hash, std::memory_order_relaxed);
+  return hash;
+}
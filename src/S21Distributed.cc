@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "s21_distributed.h"
+#include "s21_kernels.h"
+
+namespace {
+
+// Number of indices in [0, n) that fall on process `proc` out of `procs`
+// when blocks of `block` indices are dealt round-robin.
+int OwnedCount(int n, int block, int proc, int procs) {
+  int full_blocks = n / block;
+  int count = full_blocks / procs * block;
+  int extra = full_blocks % procs;
+  if (proc < extra) {
+    count += block;
+  } else if (proc == extra) {
+    count += n % block;
+  }
+  return count;
+}
+
+int GlobalIndex(int local, int block, int proc, int procs) {
+  return (local / block * procs + proc) * block + local % block;
+}
+
+// Row pointers into a row-major buffer, the layout the kernels take.
+std::vector<double*> RowPointers(double* data, int rows, int stride) {
+  std::vector<double*> pointers(rows);
+  for (int i = 0; i < rows; ++i) pointers[i] = data + 1L * i * stride;
+  return pointers;
+}
+
+}  // namespace
+
+S21DistributedMatrix::S21DistributedMatrix(S21Transport& transport,
+                                           int rows, int cols, int block,
+                                           int grid_rows)
+    : transport_(&transport), rows_(rows), cols_(cols), block_(block) {
+  int size = transport.GetSize();
+  if (rows <= 0 || cols <= 0 || block <= 0 || grid_rows < 0) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (grid_rows == 0) {
+    grid_rows = 1;
+    for (int r = 1; r * r <= size; ++r) {
+      if (size % r == 0) grid_rows = r;
+    }
+  }
+  if (size % grid_rows != 0) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  grid_rows_ = grid_rows;
+  grid_cols_ = size / grid_rows;
+  my_row_ = transport.GetRank() / grid_cols_;
+  my_col_ = transport.GetRank() % grid_cols_;
+  local_rows_ = OwnedCount(rows_, block_, my_row_, grid_rows_);
+  local_cols_ = OwnedCount(cols_, block_, my_col_, grid_cols_);
+  local_.assign(1L * local_rows_ * local_cols_, 0.0);
+}
+
+S21DistributedMatrix S21DistributedMatrix::Scatter(S21Transport& transport,
+                                                   const S21Matrix& global,
+                                                   int block, int root,
+                                                   int grid_rows) {
+  int rank = transport.GetRank(), size = transport.GetSize();
+  int shape[2] = {global.GetRows(), global.GetCols()};
+  if (rank == root) {
+    for (int peer = 0; peer < size; ++peer) {
+      if (peer != root) transport.Send(peer, shape, sizeof(shape));
+    }
+  } else {
+    transport.Receive(root, shape, sizeof(shape));
+  }
+  S21DistributedMatrix result(transport, shape[0], shape[1], block,
+                              grid_rows);
+  if (rank != root) {
+    transport.Receive(root, result.local_.data(),
+                      result.local_.size() * sizeof(double));
+    return result;
+  }
+  for (int peer = 0; peer < size; ++peer) {
+    int grid_row = peer / result.grid_cols_;
+    int grid_col = peer % result.grid_cols_;
+    int rows = OwnedCount(shape[0], block, grid_row, result.grid_rows_);
+    int cols = OwnedCount(shape[1], block, grid_col, result.grid_cols_);
+    std::vector<double> tiles(1L * rows * cols);
+    for (int i = 0; i < rows; ++i) {
+      int row = GlobalIndex(i, block, grid_row, result.grid_rows_);
+      for (int j = 0; j < cols; ++j) {
+        int col = GlobalIndex(j, block, grid_col, result.grid_cols_);
+        tiles[1L * i * cols + j] = global(row, col);
+      }
+    }
+    if (peer == root) {
+      result.local_ = std::move(tiles);
+    } else {
+      transport.Send(peer, tiles.data(), tiles.size() * sizeof(double));
+    }
+  }
+  return result;
+}
+
+S21Matrix S21DistributedMatrix::Gather(int root) const {
+  int rank = transport_->GetRank(), size = transport_->GetSize();
+  if (rank != root) {
+    transport_->Send(root, local_.data(), local_.size() * sizeof(double));
+    return S21Matrix();
+  }
+  S21Matrix global(rows_, cols_, kS21Uninitialized);
+  for (int peer = 0; peer < size; ++peer) {
+    int grid_row = peer / grid_cols_, grid_col = peer % grid_cols_;
+    int rows = OwnedCount(rows_, block_, grid_row, grid_rows_);
+    int cols = OwnedCount(cols_, block_, grid_col, grid_cols_);
+    std::vector<double> tiles;
+    if (peer == root) {
+      tiles = local_;
+    } else {
+      tiles.resize(1L * rows * cols);
+      transport_->Receive(peer, tiles.data(), tiles.size() * sizeof(double));
+    }
+    for (int i = 0; i < rows; ++i) {
+      int row = GlobalIndex(i, block_, grid_row, grid_rows_);
+      for (int j = 0; j < cols; ++j) {
+        global(row, GlobalIndex(j, block_, grid_col, grid_cols_)) =
+            tiles[1L * i * cols + j];
+      }
+    }
+  }
+  return global;
+}
+
+S21DistributedMatrix S21DistributedMatrix::MulMatrix(
+    const S21DistributedMatrix& other) const {
+  if (cols_ != other.rows_ || block_ != other.block_ ||
+      grid_rows_ != other.grid_rows_ || transport_ != other.transport_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  S21DistributedMatrix result(*transport_, rows_, other.cols_, block_,
+                              grid_rows_);
+  std::vector<double*> c_rows = RowPointers(
+      result.local_.data(), result.local_rows_, result.local_cols_);
+  for (int k0 = 0; k0 < cols_; k0 += block_) {
+    int width = std::min(block_, cols_ - k0);
+    int owner_col = k0 / block_ % grid_cols_;
+    int owner_row = k0 / block_ % grid_rows_;
+    std::vector<double> a_panel, b_panel;
+    if (my_col_ == owner_col) {
+      int col = LocalCol(k0);
+      a_panel.resize(1L * local_rows_ * width);
+      for (int i = 0; i < local_rows_; ++i) {
+        std::copy_n(local_.data() + 1L * i * local_cols_ + col, width,
+                    a_panel.data() + 1L * i * width);
+      }
+    }
+    Broadcast(a_panel, owner_col, true);
+    if (my_row_ == owner_row) {
+      int row = other.LocalRow(k0);
+      b_panel.assign(
+          other.local_.begin() + 1L * row * other.local_cols_,
+          other.local_.begin() + 1L * (row + width) * other.local_cols_);
+    }
+    Broadcast(b_panel, owner_row, false);
+    std::vector<double*> a_rows =
+        RowPointers(a_panel.data(), local_rows_, width);
+    std::vector<double*> b_rows =
+        RowPointers(b_panel.data(), width, other.local_cols_);
+    s21_detail::Gemm(false, false, local_rows_, result.local_cols_, width, 1,
+                     a_rows.data(), b_rows.data(), 1, c_rows.data());
+  }
+  return result;
+}
+
+double S21DistributedMatrix::LuFactor() {
+  if (rows_ != cols_) S21_THROW(std::invalid_argument("Invalid matrix"));
+  int n = rows_;
+  pivots_.assign(n, 0);
+  for (int k0 = 0; k0 < n; k0 += block_) {
+    int k1 = std::min(k0 + block_, n), width = k1 - k0;
+    int panel_col = k0 / block_ % grid_cols_;
+    int panel_row = k0 / block_ % grid_rows_;
+
+    // The process column holding the panel factors it column by column.
+    std::vector<double> panel_pivots(width);
+    if (my_col_ == panel_col) {
+      int col0 = LocalCol(k0);
+      for (int k = k0; k < k1; ++k) {
+        int col = col0 + k - k0;
+        double candidate[2] = {-1, static_cast<double>(k)};
+        for (int i = RowsBelow(k); i < local_rows_; ++i) {
+          double value = std::fabs(At(i, col));
+          if (value > candidate[0]) {
+            candidate[0] = value;
+            candidate[1] = GlobalRow(i);
+          }
+        }
+        // Every process of the column picks the same winner: the largest
+        // value, then the smallest row.
+        double best[2] = {candidate[0], candidate[1]};
+        for (int r = 0; r < grid_rows_; ++r) {
+          if (r != my_row_) {
+            transport_->Send(RankOf(r, my_col_), candidate, sizeof(candidate));
+          }
+        }
+        for (int r = 0; r < grid_rows_; ++r) {
+          if (r == my_row_) continue;
+          double other[2];
+          transport_->Receive(RankOf(r, my_col_), other, sizeof(other));
+          if (other[0] > best[0] ||
+              (other[0] == best[0] && other[1] < best[1])) {
+            best[0] = other[0];
+            best[1] = other[1];
+          }
+        }
+        int pivot = static_cast<int>(best[1]);
+        panel_pivots[k - k0] = pivot;
+        SwapRows(k, pivot, k0, k1);
+
+        std::vector<double> pivot_row;
+        if (my_row_ == panel_row) {
+          double* row = Row(LocalRow(k)) + col;
+          pivot_row.assign(row, row + (k1 - k));
+        }
+        Broadcast(pivot_row, panel_row, false);
+        if (pivot_row[0] == 0) continue;
+        for (int i = RowsBelow(k + 1); i < local_rows_; ++i) {
+          double* row = Row(i) + col;
+          double factor = row[0] / pivot_row[0];
+          row[0] = factor;
+          for (int j = 1; j < k1 - k; ++j) row[j] -= factor * pivot_row[j];
+        }
+      }
+    }
+    Broadcast(panel_pivots, panel_col, true);
+    for (int k = k0; k < k1; ++k) {
+      pivots_[k] = static_cast<int>(panel_pivots[k - k0]);
+      SwapRows(k, pivots_[k], 0, k0);
+      SwapRows(k, pivots_[k], k1, n);
+    }
+
+    // U12 = L11^-1 * A12 on the process row holding the block row.
+    int trailing_col = ColsBelow(k1), trailing_row = RowsBelow(k1);
+    if (my_row_ == panel_row) {
+      std::vector<double> l11;
+      int row0 = LocalRow(k0);
+      if (my_col_ == panel_col) {
+        int col0 = LocalCol(k0);
+        l11.resize(1L * width * width);
+        for (int r = 0; r < width; ++r) {
+          std::copy_n(Row(row0 + r) + col0, width, l11.data() + 1L * r * width);
+        }
+      }
+      Broadcast(l11, panel_col, true);
+      for (int r = 1; r < width; ++r) {
+        double* row = Row(row0 + r);
+        for (int s = 0; s < r; ++s) {
+          double factor = l11[1L * r * width + s];
+          const double* upper = Row(row0 + s);
+          for (int j = trailing_col; j < local_cols_; ++j) {
+            row[j] -= factor * upper[j];
+          }
+        }
+      }
+    }
+
+    // A22 -= L21 * U12 with the panels broadcast as in MulMatrix.
+    int m2 = local_rows_ - trailing_row, n2 = local_cols_ - trailing_col;
+    std::vector<double> l21, u12;
+    if (my_col_ == panel_col) {
+      int col0 = LocalCol(k0);
+      l21.resize(1L * m2 * width);
+      for (int i = 0; i < m2; ++i) {
+        std::copy_n(Row(trailing_row + i) + col0, width,
+                    l21.data() + 1L * i * width);
+      }
+    }
+    Broadcast(l21, panel_col, true);
+    if (my_row_ == panel_row) {
+      int row0 = LocalRow(k0);
+      u12.resize(1L * width * n2);
+      for (int r = 0; r < width; ++r) {
+        std::copy_n(Row(row0 + r) + trailing_col, n2, u12.data() + 1L * r * n2);
+      }
+    }
+    Broadcast(u12, panel_row, false);
+    if (m2 > 0 && n2 > 0) {
+      std::vector<double*> l_rows = RowPointers(l21.data(), m2, width);
+      std::vector<double*> u_rows = RowPointers(u12.data(), width, n2);
+      std::vector<double*> a_rows = RowPointers(
+          Row(trailing_row) + trailing_col, m2, local_cols_);
+      s21_detail::Gemm(false, false, m2, n2, width, -1, l_rows.data(),
+                       u_rows.data(), 1, a_rows.data());
+    }
+  }
+
+  // det = sign * product of the diagonal of U, multiplied across ranks in
+  // rank order so that every process gets the same value.
+  double partial = 1;
+  for (int i = 0; i < n; ++i) {
+    if (OwnsRow(i) && OwnsCol(i)) partial *= At(LocalRow(i), LocalCol(i));
+  }
+  int rank = transport_->GetRank(), size = transport_->GetSize();
+  for (int peer = 0; peer < size; ++peer) {
+    if (peer != rank) transport_->Send(peer, &partial, sizeof(partial));
+  }
+  double determinant = 1;
+  for (int peer = 0; peer < size; ++peer) {
+    double value = partial;
+    if (peer != rank) transport_->Receive(peer, &value, sizeof(value));
+    determinant *= value;
+  }
+  for (int i = 0; i < n; ++i) {
+    if (pivots_[i] != i) determinant = -determinant;
+  }
+  return determinant;
+}
+
+const std::vector<int>& S21DistributedMatrix::GetPivots() const {
+  return pivots_;
+}
+
+int S21DistributedMatrix::GetRows() const { return rows_; }
+int S21DistributedMatrix::GetCols() const { return cols_; }
+int S21DistributedMatrix::GetBlock() const { return block_; }
+int S21DistributedMatrix::GetGridRows() const { return grid_rows_; }
+int S21DistributedMatrix::GetGridCols() const { return grid_cols_; }
+int S21DistributedMatrix::GetLocalRows() const { return local_rows_; }
+int S21DistributedMatrix::GetLocalCols() const { return local_cols_; }
+
+double& S21DistributedMatrix::At(int local_row, int local_col) {
+  return Row(local_row)[local_col];
+}
+
+// Pointer arithmetic on data() stays valid when this rank owns no columns
+// and local_ is empty, where indexing local_ would not.
+double* S21DistributedMatrix::Row(int local_row) {
+  return local_.data() + 1L * local_row * local_cols_;
+}
+
+bool S21DistributedMatrix::OwnsRow(int row) const {
+  return row / block_ % grid_rows_ == my_row_;
+}
+
+bool S21DistributedMatrix::OwnsCol(int col) const {
+  return col / block_ % grid_cols_ == my_col_;
+}
+
+int S21DistributedMatrix::LocalRow(int row) const {
+  return row / (block_ * grid_rows_) * block_ + row % block_;
+}
+
+int S21DistributedMatrix::LocalCol(int col) const {
+  return col / (block_ * grid_cols_) * block_ + col % block_;
+}
+
+int S21DistributedMatrix::GlobalRow(int local_row) const {
+  return GlobalIndex(local_row, block_, my_row_, grid_rows_);
+}
+
+int S21DistributedMatrix::RankOf(int grid_row, int grid_col) const {
+  return grid_row * grid_cols_ + grid_col;
+}
+
+int S21DistributedMatrix::RowsBelow(int bound) const {
+  return OwnedCount(bound, block_, my_row_, grid_rows_);
+}
+
+int S21DistributedMatrix::ColsBelow(int bound) const {
+  return OwnedCount(bound, block_, my_col_, grid_cols_);
+}
+
+void S21DistributedMatrix::Broadcast(std::vector<double>& data, int root,
+                                     bool along_row) const {
+  int members = along_row ? grid_cols_ : grid_rows_;
+  int me = along_row ? my_col_ : my_row_;
+  auto rank_of = [&](int member) {
+    return along_row ? RankOf(my_row_, member) : RankOf(member, my_col_);
+  };
+  if (me != root) {
+    std::uint64_t count = 0;
+    transport_->Receive(rank_of(root), &count, sizeof(count));
+    data.resize(count);
+    transport_->Receive(rank_of(root), data.data(), count * sizeof(double));
+    return;
+  }
+  std::uint64_t count = data.size();
+  for (int member = 0; member < members; ++member) {
+    if (member == root) continue;
+    transport_->Send(rank_of(member), &count, sizeof(count));
+    transport_->Send(rank_of(member), data.data(), count * sizeof(double));
+  }
+}
+
+// Swaps the parts of global rows `first` and `second` that lie in columns
+// [col_begin, col_end), exchanging them between process rows if needed.
+void S21DistributedMatrix::SwapRows(int first, int second, int col_begin,
+                                    int col_end) {
+  int lo = ColsBelow(col_begin), hi = ColsBelow(col_end);
+  if (first == second || lo >= hi) return;
+  bool has_first = OwnsRow(first), has_second = OwnsRow(second);
+  if (has_first && has_second) {
+    std::swap_ranges(Row(LocalRow(first)) + lo, Row(LocalRow(first)) + hi,
+                     Row(LocalRow(second)) + lo);
+    return;
+  }
+  if (!has_first && !has_second) return;
+  int mine = has_first ? first : second;
+  int theirs = has_first ? second : first;
+  int peer = RankOf(theirs / block_ % grid_rows_, my_col_);
+  double* segment = Row(LocalRow(mine)) + lo;
+  std::vector<double> incoming(hi - lo);
+  std::size_t bytes = incoming.size() * sizeof(double);
+  if (transport_->GetRank() < peer) {
+    transport_->Send(peer, segment, bytes);
+    transport_->Receive(peer, incoming.data(), bytes);
+  } else {
+    transport_->Receive(peer, incoming.data(), bytes);
+    transport_->Send(peer, segment, bytes);
+  }
+  std::copy(incoming.begin(), incoming.end(), segment);
+}
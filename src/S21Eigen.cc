@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+// SPECTRAL DECOMPOSITIONS
+
+namespace {
+
+const int kMaxQlIterations = 60;
+const int kMaxJacobiSweeps = 60;
+const int kTridiagonalBlock = 32;
+
+// Householder reduction of the symmetric matrix `a` to tridiagonal form.
+// Diagonal goes to d, subdiagonal to e (e[n - 1] = 0). When q is given it
+// receives the orthogonal matrix with a = q * T * q^T.
+//
+// Blocked as in LAPACK's latrd: each panel of kTridiagonalBlock columns
+// builds its reflectors v and the matching w from the not yet updated
+// trailing matrix, corrected by the panel's earlier v and w, and the
+// trailing matrix then takes the whole panel as one rank-2b update, so its
+// rows pass through the cache once per panel rather than once per column.
+void Tridiagonalize(double** a, int n, std::vector<double>& d,
+                    std::vector<double>& e, double** q) {
+  std::vector<double> p(n), w_dot(kTridiagonalBlock), v_dot(kTridiagonalBlock);
+  // Reflectors of the current panel and their w, indexed by matrix row.
+  std::vector<std::vector<double>> v(kTridiagonalBlock, std::vector<double>(n));
+  std::vector<std::vector<double>> w(v);
+  std::vector<std::vector<double>> reflectors;
+  if (q) reflectors.assign(n, std::vector<double>());
+
+  for (int begin = 0; begin + 2 < n; begin += kTridiagonalBlock) {
+    int end = std::min(begin + kTridiagonalBlock, n - 2);
+    for (int k = begin; k < end; ++k) {
+      int t = k - begin, m = n - k - 1;
+      // Column k of A with the panel's earlier reflectors applied.
+      for (int s = 0; s < t; ++s) {
+        double vk = v[s][k], wk = w[s][k];
+        for (int i = k; i < n; ++i) a[i][k] -= v[s][i] * wk + w[s][i] * vk;
+      }
+      std::fill(v[t].begin(), v[t].end(), 0.0);
+      std::fill(w[t].begin(), w[t].end(), 0.0);
+      double* vt = v[t].data() + k + 1;
+      double* wt = w[t].data() + k + 1;
+      double norm = 0;
+      for (int i = 0; i < m; ++i) {
+        vt[i] = a[k + 1 + i][k];
+        norm += vt[i] * vt[i];
+      }
+      norm = std::sqrt(norm);
+      double alpha = vt[0] > 0 ? -norm : norm;
+      double v_norm = std::sqrt(norm * norm - 2 * alpha * a[k + 1][k] +
+                                alpha * alpha);
+      if (norm == 0 || v_norm == 0) {
+        std::fill(vt, vt + m, 0.0);
+        continue;
+      }
+      vt[0] -= alpha;
+      for (int i = 0; i < m; ++i) vt[i] /= v_norm;
+
+      // p = A22 * v with A22 = A22 - V * W^T - W * V^T still pending: the
+      // stored rows are multiplied in parallel and the correction follows.
+      int grain = s21_detail::GrainFor(2L * m);
+      s21_detail::ParallelFor(0, m, grain, [&](int lo, int hi) {
+        for (int i = lo; i < hi; ++i) {
+          const double* row = a[k + 1 + i] + k + 1;
+          double sum = 0;
+          for (int j = 0; j < m; ++j) sum += row[j] * vt[j];
+          p[i] = sum;
+        }
+      });
+      for (int s = 0; s < t; ++s) {
+        w_dot[s] = v_dot[s] = 0;
+        for (int i = 0; i < m; ++i) {
+          w_dot[s] += w[s][k + 1 + i] * vt[i];
+          v_dot[s] += v[s][k + 1 + i] * vt[i];
+        }
+      }
+      for (int s = 0; s < t; ++s) {
+        for (int i = 0; i < m; ++i) {
+          p[i] -= v[s][k + 1 + i] * w_dot[s] + w[s][k + 1 + i] * v_dot[s];
+        }
+      }
+      double kappa = 0;
+      for (int i = 0; i < m; ++i) kappa += vt[i] * p[i];
+      for (int i = 0; i < m; ++i) wt[i] = 2 * p[i] - 2 * kappa * vt[i];
+
+      a[k + 1][k] = a[k][k + 1] = alpha;
+      for (int i = 1; i < m; ++i) a[k + 1 + i][k] = a[k][k + 1 + i] = 0;
+      if (q) reflectors[k].assign(vt, vt + m);
+    }
+
+    // A22 -= V * W^T + W * V^T over the rows and columns past the panel.
+    int width = end - begin;
+    int grain = s21_detail::GrainFor(4L * width * (n - end));
+    s21_detail::ParallelFor(end, n, grain, [&](int lo, int hi) {
+      for (int i = lo; i < hi; ++i) {
+        double* row = a[i];
+        for (int s = 0; s < width; ++s) {
+          const double* vs = v[s].data();
+          const double* ws = w[s].data();
+          double vi = vs[i], wi = ws[i];
+          for (int j = end; j < n; ++j) row[j] -= vi * ws[j] + wi * vs[j];
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < n; ++i) {
+    d[i] = a[i][i];
+    e[i] = i + 1 < n ? a[i + 1][i] : 0;
+  }
+  if (!q) return;
+
+  // q = H_0 * H_1 * ... applied to the identity from the last reflector.
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) q[i][j] = i == j ? 1 : 0;
+  }
+  std::vector<double> dots(n);
+  for (int k = n - 3; k >= 0; --k) {
+    const std::vector<double>& r = reflectors[k];
+    int m = static_cast<int>(r.size());
+    if (m == 0) continue;
+    std::fill(dots.begin(), dots.end(), 0.0);
+    for (int i = 0; i < m; ++i) {
+      const double* row = q[k + 1 + i];
+      for (int j = 0; j < n; ++j) dots[j] += r[i] * row[j];
+    }
+    s21_detail::ParallelFor(0, m, s21_detail::GrainFor(2L * n),
+                            [&](int lo, int hi) {
+                              for (int i = lo; i < hi; ++i) {
+                                double* row = q[k + 1 + i];
+                                double ri = 2 * r[i];
+                                for (int j = 0; j < n; ++j) {
+                                  row[j] -= ri * dots[j];
+                                }
+                              }
+                            });
+  }
+}
+
+// Implicit QL iteration on the tridiagonal (d, e). Rotations are
+// accumulated into the columns of z when it is given.
+void TridiagonalQl(std::vector<double>& d, std::vector<double>& e, double** z,
+                   int n) {
+  const double eps = std::numeric_limits<double>::epsilon();
+  for (int l = 0; l < n; ++l) {
+    int iterations = 0;
+    int m;
+    do {
+      for (m = l; m < n - 1; ++m) {
+        double dd = std::fabs(d[m]) + std::fabs(d[m + 1]);
+        if (std::fabs(e[m]) <= eps * dd) break;
+      }
+      if (m == l) break;
+      if (iterations++ == kMaxQlIterations) {
+        S21_THROW(std::runtime_error("Eigenvalue iteration did not converge"));
+      }
+      double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+      double r = std::hypot(g, 1.0);
+      g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+      double s = 1, c = 1, p = 0;
+      int i;
+      for (i = m - 1; i >= l; --i) {
+        double f = s * e[i];
+        double b = c * e[i];
+        r = std::hypot(f, g);
+        e[i + 1] = r;
+        if (r == 0) {
+          d[i + 1] -= p;
+          e[m] = 0;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = d[i + 1] - p;
+        r = (d[i] - g) * s + 2.0 * c * b;
+        p = s * r;
+        d[i + 1] = g + p;
+        g = c * r - b;
+        if (z) {
+          for (int k = 0; k < n; ++k) {
+            f = z[k][i + 1];
+            z[k][i + 1] = s * z[k][i] + c * f;
+            z[k][i] = c * z[k][i] - s * f;
+          }
+        }
+      }
+      if (r == 0 && i >= l) continue;
+      d[l] -= p;
+      e[l] = g;
+      e[m] = 0;
+    } while (m != l);
+  }
+}
+
+// One-sided Jacobi on the rows of w (k x len): rotates row pairs until
+// they are mutually orthogonal, applying the same rotations to the rows
+// of vt when it is given. Pairs are visited in round-robin order so each
+// round consists of independent rotations that run in parallel.
+void OrthogonalizeRows(double** w, int k, int len, double** vt) {
+  const double eps = std::numeric_limits<double>::epsilon();
+  int players = k + (k % 2);
+  std::vector<int> order(players);
+  std::iota(order.begin(), order.end(), 0);
+
+  for (int sweep = 0; sweep < kMaxJacobiSweeps; ++sweep) {
+    bool rotated = false;
+    for (int round = 0; round + 1 < players; ++round) {
+      std::vector<char> touched(players / 2, 0);
+      s21_detail::ParallelFor(
+          0, players / 2, s21_detail::GrainFor(6L * (len + k)),
+          [&](int lo, int hi) {
+            for (int pair = lo; pair < hi; ++pair) {
+              int p = order[pair], q = order[players - 1 - pair];
+              if (p >= k || q >= k) continue;
+              if (p > q) std::swap(p, q);
+              double alpha = 0, beta = 0, gamma = 0;
+              for (int j = 0; j < len; ++j) {
+                alpha += w[p][j] * w[p][j];
+                beta += w[q][j] * w[q][j];
+                gamma += w[p][j] * w[q][j];
+              }
+              if (std::fabs(gamma) <= eps * std::sqrt(alpha * beta)) continue;
+              double zeta = (beta - alpha) / (2 * gamma);
+              double t = std::copysign(1.0, zeta) /
+                         (std::fabs(zeta) + std::sqrt(1 + zeta * zeta));
+              double c = 1 / std::sqrt(1 + t * t), s = c * t;
+              for (int j = 0; j < len; ++j) {
+                double wp = w[p][j], wq = w[q][j];
+                w[p][j] = c * wp - s * wq;
+                w[q][j] = s * wp + c * wq;
+              }
+              if (vt) {
+                for (int j = 0; j < k; ++j) {
+                  double vp = vt[p][j], vq = vt[q][j];
+                  vt[p][j] = c * vp - s * vq;
+                  vt[q][j] = s * vp + c * vq;
+                }
+              }
+              touched[pair] = 1;
+            }
+          });
+      for (char flag : touched) rotated = rotated || flag;
+      std::rotate(order.begin() + 1, order.end() - 1, order.end());
+    }
+    if (!rotated) return;
+  }
+  S21_THROW(std::runtime_error("Singular value iteration did not converge"));
+}
+
+// Fills the zero columns of u (rows x cols) with unit vectors orthogonal
+// to the other columns, completing an orthonormal set.
+void CompleteOrthonormal(double** u, int rows, int cols,
+                         const std::vector<char>& filled) {
+  std::vector<double> candidate(rows);
+  int next_axis = 0;
+  for (int c = 0; c < cols; ++c) {
+    if (filled[c]) continue;
+    while (next_axis < rows) {
+      std::fill(candidate.begin(), candidate.end(), 0.0);
+      candidate[next_axis++] = 1;
+      for (int other = 0; other < cols; ++other) {
+        if (other == c || (!filled[other] && other > c)) continue;
+        double dot = 0;
+        for (int i = 0; i < rows; ++i) dot += u[i][other] * candidate[i];
+        for (int i = 0; i < rows; ++i) candidate[i] -= dot * u[i][other];
+      }
+      double norm = 0;
+      for (double x : candidate) norm += x * x;
+      norm = std::sqrt(norm);
+      if (norm > 0.5) {
+        for (int i = 0; i < rows; ++i) u[i][c] = candidate[i] / norm;
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+S21Matrix S21Matrix::SymmetricEigen(S21Matrix* vectors) const {
+  if (IsInvalid() || rows_ != cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = i + 1; j < cols_; ++j) {
+      if (std::fabs(matrix_[i][j] - matrix_[j][i]) >= 1e-07) {
+        S21_THROW(std::invalid_argument("Invalid matrix"));
+      }
+    }
+  }
+  int n = rows_;
+  S21Matrix work(*this);
+  work.touch();
+  S21Matrix basis(n, n, kS21Uninitialized);
+  double** z = vectors ? basis.matrix_ : nullptr;
+  std::vector<double> d(n), e(n);
+  Tridiagonalize(work.matrix_, n, d, e, z);
+  TridiagonalQl(d, e, z, n);
+
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&d](int x, int y) { return d[x] < d[y]; });
+  S21Matrix values(n, 1, kS21Uninitialized);
+  for (int i = 0; i < n; ++i) values.matrix_[i][0] = d[order[i]];
+  if (vectors) {
+    S21Matrix sorted(n, n, kS21Uninitialized);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) sorted.matrix_[i][j] = z[i][order[j]];
+    }
+    *vectors = std::move(sorted);
+  }
+  return values;
+}
+
+S21Matrix S21Matrix::SVD(S21Matrix* u, S21Matrix* v) const {
+  if (IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  // Work on the rows of w = A^T (or A when it is wide) so that the column
+  // rotations of one-sided Jacobi touch contiguous memory.
+  bool wide = rows_ < cols_;
+  S21Matrix w = wide ? S21Matrix(*this) : Transpose();
+  w.touch();
+  int k = w.rows_, len = w.cols_;
+  bool want_vectors = u || v;
+  S21Matrix vt(k, k);
+  if (want_vectors) {
+    for (int i = 0; i < k; ++i) vt.matrix_[i][i] = 1;
+  }
+  OrthogonalizeRows(w.matrix_, k, len, want_vectors ? vt.matrix_ : nullptr);
+
+  std::vector<double> sigma(k);
+  for (int i = 0; i < k; ++i) {
+    double sum = 0;
+    for (int j = 0; j < len; ++j) sum += w.matrix_[i][j] * w.matrix_[i][j];
+    sigma[i] = std::sqrt(sum);
+  }
+  std::vector<int> order(k);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&sigma](int x, int y) { return sigma[x] > sigma[y]; });
+  S21Matrix values(k, 1, kS21Uninitialized);
+  for (int i = 0; i < k; ++i) values.matrix_[i][0] = sigma[order[i]];
+  if (!want_vectors) return values;
+
+  // Rows of w divided by sigma are the singular vectors of length `len`,
+  // rows of vt are the ones of length k.
+  double cutoff = std::numeric_limits<double>::epsilon() * len *
+                  (k ? sigma[order[0]] : 0);
+  S21Matrix long_side(len, k);
+  S21Matrix short_side(k, k, kS21Uninitialized);
+  std::vector<char> filled(k, 0);
+  for (int c = 0; c < k; ++c) {
+    int src = order[c];
+    for (int i = 0; i < k; ++i) short_side.matrix_[i][c] = vt.matrix_[src][i];
+    if (sigma[src] > cutoff) {
+      for (int i = 0; i < len; ++i) {
+        long_side.matrix_[i][c] = w.matrix_[src][i] / sigma[src];
+      }
+      filled[c] = 1;
+    }
+  }
+  CompleteOrthonormal(long_side.matrix_, len, k, filled);
+  S21Matrix* long_out = wide ? v : u;
+  S21Matrix* short_out = wide ? u : v;
+  if (long_out) *long_out = std::move(long_side);
+  if (short_out) *short_out = std::move(short_side);
+  return values;
+}
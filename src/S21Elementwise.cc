@@ -0,0 +1,118 @@
+#include "s21_elementwise.h"
+
+#include <utility>
+
+#include "s21_parallel.h"
+
+void S21Elementwise::Prepare(const S21Matrix& a, int rows, int cols,
+                             S21Matrix* out) {
+  if (out == nullptr || a.IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (out->rows_ != rows || out->cols_ != cols || out->IsInvalid()) {
+    *out = S21Matrix(rows, cols, kS21Uninitialized);
+  }
+  out->touch();
+}
+
+void S21Elementwise::ForEachRow(
+    const S21Matrix& a, S21Matrix* out,
+    const std::function<void(const double*, double*)>& row) {
+  const double* const* in = a.matrix_;
+  double* const* result = out->matrix_;
+  s21_detail::ParallelFor(0, a.rows_, s21_detail::GrainFor(4L * a.cols_),
+                          [&](int lo, int hi) {
+                            for (int i = lo; i < hi; ++i) row(in[i], result[i]);
+                          });
+}
+
+template <class Op>
+void S21Elementwise::Broadcast(const S21Matrix& a, const S21Matrix& b, Op op,
+                               S21Matrix* out) {
+  int rows = a.rows_, cols = a.cols_;
+  if (a.IsInvalid() || b.IsInvalid() || (b.rows_ != rows && b.rows_ != 1) ||
+      (b.cols_ != cols && b.cols_ != 1)) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (out == &b && (b.rows_ != rows || b.cols_ != cols)) {
+    S21Matrix result;
+    Broadcast(a, b, op, &result);
+    *out = std::move(result);
+    return;
+  }
+  Prepare(a, rows, cols, out);
+  const double* const* left = a.matrix_;
+  const double* const* right = b.matrix_;
+  double* const* result = out->matrix_;
+  bool row_operand = b.rows_ == 1, scalar_per_row = b.cols_ == 1;
+  s21_detail::ParallelFor(
+      0, rows, s21_detail::GrainFor(2L * cols), [&](int lo, int hi) {
+        for (int i = lo; i < hi; ++i) {
+          const double* x = left[i];
+          const double* y = right[row_operand ? 0 : i];
+          double* z = result[i];
+          if (scalar_per_row) {
+            double value = y[0];
+            for (int j = 0; j < cols; ++j) z[j] = op(x[j], value);
+          } else {
+            for (int j = 0; j < cols; ++j) z[j] = op(x[j], y[j]);
+          }
+        }
+      });
+}
+
+void S21Elementwise::Kronecker(const S21Matrix& a, const S21Matrix& b,
+                               S21Matrix* out) {
+  if (a.IsInvalid() || b.IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (out == &a || out == &b) {
+    S21Matrix result;
+    Kronecker(a, b, &result);
+    *out = std::move(result);
+    return;
+  }
+  int b_rows = b.rows_, b_cols = b.cols_, a_cols = a.cols_;
+  Prepare(a, a.rows_ * b_rows, a_cols * b_cols, out);
+  double* const* result = out->matrix_;
+  // Output row i * b_rows + k is a(i, :) scaling copies of b(k, :).
+  s21_detail::ParallelFor(
+      0, a.rows_ * b_rows, s21_detail::GrainFor(1L * a_cols * b_cols),
+      [&](int lo, int hi) {
+        for (int r = lo; r < hi; ++r) {
+          const double* a_row = a.matrix_[r / b_rows];
+          const double* b_row = b.matrix_[r % b_rows];
+          double* z = result[r];
+          for (int j = 0; j < a_cols; ++j, z += b_cols) {
+            double factor = a_row[j];
+            for (int l = 0; l < b_cols; ++l) z[l] = factor * b_row[l];
+          }
+        }
+      });
+}
+
+void S21Elementwise::HadamardMul(const S21Matrix& a, const S21Matrix& b,
+                                 S21Matrix* out) {
+  if (a.rows_ != b.rows_ || a.cols_ != b.cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  Broadcast(a, b, [](double x, double y) { return x * y; }, out);
+}
+
+void S21Elementwise::HadamardDiv(const S21Matrix& a, const S21Matrix& b,
+                                 S21Matrix* out) {
+  if (a.rows_ != b.rows_ || a.cols_ != b.cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  Broadcast(a, b, [](double x, double y) { return x / y; }, out);
+}
+
+void S21Elementwise::BroadcastAdd(const S21Matrix& a, const S21Matrix& b,
+                                  S21Matrix* out) {
+  Broadcast(a, b, [](double x, double y) { return x + y; }, out);
+}
+
+void S21Elementwise::BroadcastMul(const S21Matrix& a, const S21Matrix& b,
+                                  S21Matrix* out) {
+  Broadcast(a, b, [](double x, double y) { return x * y; }, out);
+}
@@ -0,0 +1,246 @@
+#include <vector>
+
+#include "s21_incremental_inverse.h"
+#include "s21_kernels.h"
+#include "s21_parallel.h"
+
+S21IncrementalInverse::S21IncrementalInverse(const S21Matrix& matrix,
+                                             int refactor_interval)
+    : matrix_(matrix),
+      inverse_(matrix.GetRows(), matrix.GetCols(), kS21Uninitialized),
+      determinant_(0),
+      refactor_interval_(refactor_interval),
+      pending_updates_(0) {
+  if (matrix.IsInvalid() || matrix.rows_ != matrix.cols_ ||
+      refactor_interval <= 0) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  Refactorize();
+}
+
+void S21IncrementalInverse::Refactorize() {
+  int n = matrix_.rows_;
+  S21Matrix inverse(n, n, kS21Uninitialized);
+  double determinant = 0;
+  Factorize(matrix_, &inverse, &determinant);
+  inverse_ = std::move(inverse);
+  determinant_ = determinant;
+  pending_updates_ = 0;
+}
+
+// Writes the inverse and determinant of matrix into *inverse and
+// *determinant, throwing before it writes when matrix is singular.
+void S21IncrementalInverse::Factorize(const S21Matrix& matrix,
+                                      S21Matrix* inverse,
+                                      double* determinant) {
+  int n = matrix.rows_;
+  S21Matrix lu(matrix);
+  lu.touch();
+  std::vector<int> pivots(n);
+  double value = s21_detail::LuFactor(lu.matrix_, n, pivots.data());
+  if (std::fabs(value) < 1e-6) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  inverse->touch();
+  s21_detail::LuInverse(lu.matrix_, n, pivots.data(), inverse->matrix_);
+  *determinant = value;
+}
+
+// Refactorizes *matrix and installs it with its inverse. Nothing is
+// changed if that throws.
+void S21IncrementalInverse::Install(S21Matrix* matrix) {
+  int n = matrix->rows_;
+  S21Matrix inverse(n, n, kS21Uninitialized);
+  double determinant = 0;
+  Factorize(*matrix, &inverse, &determinant);
+  matrix_ = std::move(*matrix);
+  inverse_ = std::move(inverse);
+  determinant_ = determinant;
+  pending_updates_ = 0;
+}
+
+// The update about to be made is the one after which the interval asks
+// for a refactorization. It then works on a copy of the matrix, since
+// the O(n^3) refactorization dwarfs the copy; otherwise it is applied in
+// place.
+bool S21IncrementalInverse::RefactorDue() const {
+  return pending_updates_ + 1 >= refactor_interval_;
+}
+
+void S21IncrementalInverse::ReplaceRow(int row, const S21Matrix& values) {
+  int n = matrix_.rows_;
+  if (row < 0 || row >= n || values.rows_ != 1 || values.cols_ != n) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  if (RefactorDue()) {
+    S21Matrix matrix(matrix_);
+    matrix.touch();
+    for (int j = 0; j < n; ++j) matrix.matrix_[row][j] = values.matrix_[0][j];
+    Install(&matrix);
+    return;
+  }
+  std::vector<double> u(n, 0.0), v(n);
+  u[row] = 1;
+  for (int j = 0; j < n; ++j) {
+    v[j] = values.matrix_[0][j] - matrix_.matrix_[row][j];
+  }
+  ApplyRankOne(u.data(), v.data());
+  for (int j = 0; j < n; ++j) matrix_.matrix_[row][j] = values.matrix_[0][j];
+}
+
+void S21IncrementalInverse::ReplaceCol(int col, const S21Matrix& values) {
+  int n = matrix_.rows_;
+  if (col < 0 || col >= n || values.rows_ != n || values.cols_ != 1) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  if (RefactorDue()) {
+    S21Matrix matrix(matrix_);
+    matrix.touch();
+    for (int i = 0; i < n; ++i) matrix.matrix_[i][col] = values.matrix_[i][0];
+    Install(&matrix);
+    return;
+  }
+  std::vector<double> u(n), v(n, 0.0);
+  v[col] = 1;
+  for (int i = 0; i < n; ++i) {
+    u[i] = values.matrix_[i][0] - matrix_.matrix_[i][col];
+  }
+  ApplyRankOne(u.data(), v.data());
+  for (int i = 0; i < n; ++i) matrix_.matrix_[i][col] = values.matrix_[i][0];
+}
+
+// Sherman-Morrison: inv(A + u v^T) = B - (B u)(v^T B) / (1 + v^T B u),
+// det(A + u v^T) = det(A) * (1 + v^T B u), applied to inverse_ and
+// determinant_. The matrix itself is left to the caller, which knows
+// which entries actually changed; it is unshared here, before anything
+// is written, so that the caller's writes cannot fail.
+void S21IncrementalInverse::ApplyRankOne(const double* u, const double* v) {
+  int n = matrix_.rows_;
+  double** b = inverse_.matrix_;
+  std::vector<double> bu(n), vb(n, 0.0);
+  for (int i = 0; i < n; ++i) {
+    double sum = 0;
+    for (int j = 0; j < n; ++j) sum += b[i][j] * u[j];
+    bu[i] = sum;
+  }
+  for (int i = 0; i < n; ++i) {
+    if (v[i] == 0) continue;
+    for (int j = 0; j < n; ++j) vb[j] += v[i] * b[i][j];
+  }
+  double factor = 1;
+  for (int i = 0; i < n; ++i) factor += v[i] * bu[i];
+  if (std::fabs(determinant_ * factor) < 1e-6) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  double scale = 1 / factor;
+  matrix_.touch();
+  inverse_.touch();
+  b = inverse_.matrix_;
+  s21_detail::ParallelFor(0, n, s21_detail::GrainFor(2L * n),
+                          [&](int lo, int hi) {
+                            for (int i = lo; i < hi; ++i) {
+                              double coeff = bu[i] * scale;
+                              double* row = b[i];
+                              for (int j = 0; j < n; ++j) {
+                                row[j] -= coeff * vb[j];
+                              }
+                            }
+                          });
+  determinant_ *= factor;
+  ++pending_updates_;
+}
+
+// Woodbury: with C = I + V^T B U,
+// inv(A + U V^T) = B - (B U) inv(C) (V^T B), det(A + U V^T) = det(A) det(C).
+void S21IncrementalInverse::RankUpdate(const S21Matrix& u,
+                                       const S21Matrix& v) {
+  int n = matrix_.rows_;
+  if (u.IsInvalid() || v.IsInvalid() || u.rows_ != n || v.rows_ != n ||
+      u.cols_ != v.cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int k = u.cols_;
+  auto add_product = [&u, &v, n, k](double** a) {
+    for (int i = 0; i < n; ++i) {
+      for (int c = 0; c < k; ++c) {
+        double weight = u.matrix_[i][c];
+        if (weight == 0) continue;
+        for (int j = 0; j < n; ++j) a[i][j] += weight * v.matrix_[j][c];
+      }
+    }
+  };
+  if (RefactorDue()) {
+    S21Matrix matrix(matrix_);
+    matrix.touch();
+    add_product(matrix.matrix_);
+    Install(&matrix);
+    return;
+  }
+  double** b = inverse_.matrix_;
+  S21Matrix bu(n, k), vb(k, n), capacity(k, k);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      for (int c = 0; c < k; ++c) bu.matrix_[i][c] += b[i][j] * u.matrix_[j][c];
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    for (int c = 0; c < k; ++c) {
+      double weight = v.matrix_[i][c];
+      if (weight == 0) continue;
+      for (int j = 0; j < n; ++j) vb.matrix_[c][j] += weight * b[i][j];
+    }
+  }
+  for (int r = 0; r < k; ++r) {
+    capacity.matrix_[r][r] = 1;
+    for (int i = 0; i < n; ++i) {
+      for (int c = 0; c < k; ++c) {
+        capacity.matrix_[r][c] += v.matrix_[i][r] * bu.matrix_[i][c];
+      }
+    }
+  }
+  std::vector<int> pivots(k);
+  double factor = s21_detail::LuFactor(capacity.matrix_, k, pivots.data());
+  if (std::fabs(determinant_ * factor) < 1e-6) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  matrix_.touch();
+  inverse_.touch();
+  b = inverse_.matrix_;
+  // vb becomes inv(C) * V^T B
+  s21_detail::LuSolve(capacity.matrix_, k, pivots.data(), vb.matrix_, n);
+  s21_detail::ParallelFor(0, n, s21_detail::GrainFor(2L * n * k),
+                          [&](int lo, int hi) {
+                            for (int i = lo; i < hi; ++i) {
+                              double* row = b[i];
+                              for (int c = 0; c < k; ++c) {
+                                double coeff = bu.matrix_[i][c];
+                                const double* other = vb.matrix_[c];
+                                for (int j = 0; j < n; ++j) {
+                                  row[j] -= coeff * other[j];
+                                }
+                              }
+                            }
+                          });
+  add_product(matrix_.matrix_);
+  determinant_ *= factor;
+  ++pending_updates_;
+}
+
+const S21Matrix& S21IncrementalInverse::GetMatrix() const { return matrix_; }
+
+const S21Matrix& S21IncrementalInverse::GetInverse() const {
+  return inverse_;
+}
+
+double S21IncrementalInverse::GetDeterminant() const { return determinant_; }
+
+int S21IncrementalInverse::GetRefactorInterval() const {
+  return refactor_interval_;
+}
+
+void S21IncrementalInverse::SetRefactorInterval(int refactor_interval) {
+  if (refactor_interval <= 0) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  refactor_interval_ = refactor_interval;
+}
@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_parallel.h"
+
+namespace {
+
+// s + e == a + b exactly (Knuth), without branches.
+inline void TwoSum(double a, double b, double& s, double& e) {
+  s = a + b;
+  double z = s - a;
+  e = (a - (s - z)) + (b - z);
+}
+
+// p + e == a * b exactly. Without hardware FMA the factors are split into
+// 26-bit halves (Veltkamp/Dekker), which keeps the loop vectorizable.
+inline void TwoProduct(double a, double b, double& p, double& e) {
+  p = a * b;
+#ifdef __FMA__
+  e = std::fma(a, b, -p);
+#else
+  const double kSplit = 134217729.0;  // 2^27 + 1
+  double t = kSplit * a;
+  double a_high = t - (t - a);
+  double a_low = a - a_high;
+  t = kSplit * b;
+  double b_high = t - (t - b);
+  double b_low = b - b_high;
+  e = ((a_high * b_high - p) + a_high * b_low + a_low * b_high) +
+      a_low * b_low;
+#endif
+}
+
+// sum + carry accumulates a * b. The compensated mode only corrects the
+// additions, kTwoSum also the rounding of the product. TwoSum is used in
+// place of Neumaier's branch so that the loops vectorize.
+template <S21Accumulation kMode>
+inline void Accumulate(double a, double b, double& sum, double& carry) {
+  double product, product_error = 0, t, sum_error;
+  if (kMode == S21Accumulation::kCompensated) {
+    product = a * b;
+  } else {
+    TwoProduct(a, b, product, product_error);
+  }
+  TwoSum(sum, product, t, sum_error);
+  sum = t;
+  carry += product_error + sum_error;
+}
+
+// Gemm with every dot product carried as an unevaluated sum + carry.
+template <S21Accumulation kMode>
+void GemmAccurate(bool trans_a, bool trans_b, int m, int n, int k,
+                  double alpha, const double* const* a,
+                  const double* const* b, double beta, double** c) {
+  // Same blocking as the fast kernel: kRows rows of c share every row of
+  // b, and their kBlock-wide accumulators stay in L1.
+  const int kRows = 4;
+  const int kBlock = 256;
+  // Near overflow the error terms turn into NaN (inf - inf, or the
+  // Dekker split overflowing), so only the sum is kept, as plain
+  // summation would.
+  auto store = [alpha, beta](double& out, double sum, double carry) {
+    double dot = std::isfinite(sum + carry) ? sum + carry : sum;
+    out = beta == 0 ? alpha * dot : alpha * dot + beta * out;
+  };
+  s21_detail::ParallelFor(
+      0, m, s21_detail::GrainFor(8L * n * k), [&](int lo, int hi) {
+        std::vector<double> a_rows(1L * kRows * k);
+        std::vector<double> sums(kRows * kBlock), carries(kRows * kBlock);
+        for (int i0 = lo; i0 < hi; i0 += kRows) {
+          int rows = std::min(kRows, hi - i0);
+          for (int r = 0; r < rows; ++r) {
+            double* a_row = &a_rows[1L * r * k];
+            int i = i0 + r;
+            for (int p = 0; p < k; ++p) {
+              a_row[p] = trans_a ? a[p][i] : a[i][p];
+            }
+          }
+          if (trans_b) {
+            // Contiguous dot products in four lanes, merged exactly.
+            for (int r = 0; r < rows; ++r) {
+              const double* a_row = &a_rows[1L * r * k];
+              for (int j = 0; j < n; ++j) {
+                const double* b_row = b[j];
+                double lane_sum[4] = {0, 0, 0, 0};
+                double lane_carry[4] = {0, 0, 0, 0};
+                int p = 0;
+                for (; p + 4 <= k; p += 4) {
+                  for (int l = 0; l < 4; ++l) {
+                    Accumulate<kMode>(a_row[p + l], b_row[p + l],
+                                      lane_sum[l], lane_carry[l]);
+                  }
+                }
+                for (; p < k; ++p) {
+                  Accumulate<kMode>(a_row[p], b_row[p], lane_sum[0],
+                                    lane_carry[0]);
+                }
+                double total = lane_sum[0];
+                double error = lane_carry[0];
+                for (int l = 1; l < 4; ++l) {
+                  double merged, merge_error;
+                  TwoSum(total, lane_sum[l], merged, merge_error);
+                  total = merged;
+                  error += lane_carry[l] + merge_error;
+                }
+                store(c[i0 + r][j], total, error);
+              }
+            }
+            continue;
+          }
+          for (int j0 = 0; j0 < n; j0 += kBlock) {
+            int width = std::min(kBlock, n - j0);
+            std::fill(sums.begin(), sums.end(), 0.0);
+            std::fill(carries.begin(), carries.end(), 0.0);
+            for (int p = 0; p < k; ++p) {
+              const double* b_row = b[p] + j0;
+              for (int r = 0; r < rows; ++r) {
+                double factor = a_rows[1L * r * k + p];
+                double* sum = &sums[r * kBlock];
+                double* carry = &carries[r * kBlock];
+                for (int j = 0; j < width; ++j) {
+                  Accumulate<kMode>(factor, b_row[j], sum[j], carry[j]);
+                }
+              }
+            }
+            for (int r = 0; r < rows; ++r) {
+              double* row = c[i0 + r] + j0;
+              for (int j = 0; j < width; ++j) {
+                store(row[j], sums[r * kBlock + j], carries[r * kBlock + j]);
+              }
+            }
+          }
+        }
+      });
+}
+
+// Dot product of two contiguous ranges in four independent partial sums.
+inline double Dot(const double* x, const double* y, int count) {
+  double sum[4] = {0, 0, 0, 0};
+  int p = 0;
+  for (; p + 4 <= count; p += 4) {
+    for (int l = 0; l < 4; ++l) sum[l] += x[p + l] * y[p + l];
+  }
+  for (; p < count; ++p) sum[0] += x[p] * y[p];
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+// The innermost loops of the fast kernels are compiled twice, for AVX2 and
+// for the baseline ISA, and the loader binds the variant the CPU supports.
+// Both do the same operations in the same order, so results do not depend
+// on the machine.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && \
+    defined(__linux__)
+#define S21_ISA_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define S21_ISA_CLONES
+#endif
+
+// c[i][j0, j1) += alpha * op(a)[i][p] * b[p][j0, j1) for i in [i0, i1).
+S21_ISA_CLONES void GemmBlock(bool trans_a, double alpha,
+                              const double* const* a, const double* const* b,
+                              double* const* c, int i0, int i1, int j0,
+                              int j1, int k) {
+  for (int p = 0; p < k; ++p) {
+    const double* b_row = b[p];
+    for (int i = i0; i < i1; ++i) {
+      double factor = alpha * (trans_a ? a[p][i] : a[i][p]);
+      double* row = c[i];
+      for (int j = j0; j < j1; ++j) row[j] += factor * b_row[j];
+    }
+  }
+}
+
+// row[j] += x . b[j] for j in [0, n), every dot product of length k.
+S21_ISA_CLONES void DotRows(const double* x, const double* const* b,
+                            double* row, int n, int k) {
+  for (int j = 0; j < n; ++j) row[j] += Dot(x, b[j], k);
+}
+
+// y += alpha * x over count entries.
+S21_ISA_CLONES void Axpy(int count, double alpha, const double* x,
+                         double* y) {
+  for (int j = 0; j < count; ++j) y[j] += alpha * x[j];
+}
+
+// Calls fn(i) for every i in [begin, end), handing out i together with its
+// mirror end - 1 - (i - begin): for loops whose cost grows or shrinks
+// linearly with i every chunk then gets about the same work.
+template <class Fn>
+void ParallelForPaired(int begin, int end, long work_per_pair, Fn fn) {
+  int pairs = (end - begin + 1) / 2;
+  s21_detail::ParallelFor(
+      0, pairs, s21_detail::GrainFor(work_per_pair), [&](int lo, int hi) {
+        for (int t = lo; t < hi; ++t) {
+          fn(begin + t);
+          if (end - 1 - t != begin + t) fn(end - 1 - t);
+        }
+      });
+}
+
+}  // namespace
+
+namespace s21_detail {
+
+double LuFactor(double** a, int n, int* pivots) {
+  double determinant = 1;
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::fabs(a[i][k]) > std::fabs(a[pivot][k])) pivot = i;
+    }
+    pivots[k] = pivot;
+    if (a[pivot][k] == 0) return 0;
+    if (pivot != k) {
+      std::swap_ranges(a[k], a[k] + n, a[pivot]);
+      determinant = -determinant;
+    }
+    const double* pivot_row = a[k];
+    double inv_pivot = 1 / pivot_row[k];
+    determinant *= pivot_row[k];
+    int tail = n - k - 1;
+    ParallelFor(k + 1, n, GrainFor(2L * tail), [&](int lo, int hi) {
+      for (int i = lo; i < hi; ++i) {
+        double* row = a[i];
+        double factor = row[k] * inv_pivot;
+        row[k] = factor;
+        for (int j = k + 1; j < n; ++j) row[j] -= factor * pivot_row[j];
+      }
+    });
+  }
+  return determinant;
+}
+
+void LuSolve(double* const* lu, int n, const int* pivots, double** b,
+             int nrhs) {
+  for (int i = 0; i < n; ++i) {
+    if (pivots[i] != i) std::swap_ranges(b[i], b[i] + nrhs, b[pivots[i]]);
+  }
+  // Every column of b is independent, so threads take column ranges.
+  ParallelFor(0, nrhs, GrainFor(2L * n * n), [&](int lo, int hi) {
+    for (int i = 1; i < n; ++i) {
+      double* row = b[i];
+      for (int k = 0; k < i; ++k) {
+        double factor = lu[i][k];
+        const double* other = b[k];
+        for (int j = lo; j < hi; ++j) row[j] -= factor * other[j];
+      }
+    }
+    for (int i = n - 1; i >= 0; --i) {
+      double* row = b[i];
+      for (int k = i + 1; k < n; ++k) {
+        double factor = lu[i][k];
+        const double* other = b[k];
+        for (int j = lo; j < hi; ++j) row[j] -= factor * other[j];
+      }
+      double inv_diagonal = 1 / lu[i][i];
+      for (int j = lo; j < hi; ++j) row[j] *= inv_diagonal;
+    }
+  });
+}
+
+bool CholeskyFactor(double** a, int n, double* determinant) {
+  const int block = CholeskyBlock();
+  double product = 1;
+  for (int k0 = 0; k0 < n; k0 += block) {
+    int k1 = std::min(k0 + block, n), width = k1 - k0;
+    for (int j = k0; j < k1; ++j) {
+      double pivot = a[j][j] - Dot(a[j] + k0, a[j] + k0, j - k0);
+      if (!(pivot > 0)) return false;
+      product *= pivot;
+      double diagonal = std::sqrt(pivot);
+      a[j][j] = diagonal;
+      for (int i = j + 1; i < k1; ++i) {
+        a[i][j] = (a[i][j] - Dot(a[i] + k0, a[j] + k0, j - k0)) / diagonal;
+      }
+    }
+    // L21 = A21 * L11^-T, every row on its own.
+    ParallelFor(k1, n, GrainFor(1L * width * width), [&](int lo, int hi) {
+      for (int i = lo; i < hi; ++i) {
+        for (int j = k0; j < k1; ++j) {
+          a[i][j] = (a[i][j] - Dot(a[i] + k0, a[j] + k0, j - k0)) / a[j][j];
+        }
+      }
+    });
+    // Lower triangle of A22 -= L21 * L21^T.
+    ParallelForPaired(k1, n, 2L * width * (n - k1 + 1), [&](int i) {
+      const double* row = a[i] + k0;
+      for (int j = k1; j <= i; ++j) a[i][j] -= Dot(row, a[j] + k0, width);
+    });
+  }
+  *determinant = product;
+  return true;
+}
+
+void CholeskyInverse(const double* const* l, int n, double** out) {
+  // Row j of v is column j of L^-1, so v = L^-T is upper triangular and
+  // both products below read contiguous rows.
+  std::vector<double> v(1L * n * n, 0.0);
+  ParallelForPaired(0, n, 1L * n * n, [&](int j) {
+    double* row = &v[1L * j * n];
+    row[j] = 1 / l[j][j];
+    for (int i = j + 1; i < n; ++i) {
+      row[i] = -Dot(l[i] + j, row + j, i - j) / l[i][i];
+    }
+  });
+  // a^-1 = L^-T * L^-1 = v * v^T; each entry is computed once and stored
+  // on both sides of the diagonal.
+  ParallelFor(0, n, GrainFor(1L * n * n), [&](int lo, int hi) {
+    for (int i = lo; i < hi; ++i) {
+      const double* row = &v[1L * i * n];
+      for (int j = 0; j <= i; ++j) {
+        out[i][j] = out[j][i] = Dot(row + i, &v[1L * j * n] + i, n - i);
+      }
+    }
+  });
+}
+
+void LuInverse(double* const* lu, int n, const int* pivots, double** out) {
+  for (int i = 0; i < n; ++i) {
+    std::fill(out[i], out[i] + n, 0.0);
+    out[i][i] = 1;
+  }
+  LuSolve(lu, n, pivots, out, n);
+}
+
+void Multiply(const double* const* a, const double* const* b, double** c,
+              int m, int k, int n) {
+  Gemm(false, false, m, n, k, 1, a, b, 0, c);
+}
+
+void Gemm(bool trans_a, bool trans_b, int m, int n, int k, double alpha,
+          const double* const* a, const double* const* b, double beta,
+          double** c, S21Accumulation accumulation) {
+  if (accumulation == S21Accumulation::kCompensated) {
+    GemmAccurate<S21Accumulation::kCompensated>(trans_a, trans_b, m, n, k,
+                                                alpha, a, b, beta, c);
+    return;
+  }
+  if (accumulation == S21Accumulation::kTwoSum) {
+    GemmAccurate<S21Accumulation::kTwoSum>(trans_a, trans_b, m, n, k, alpha,
+                                           a, b, beta, c);
+    return;
+  }
+  // Rows of c are updated GemmRows() at a time so that every row of b read
+  // from memory is used several times, over column blocks of GemmCols()
+  // that keep those rows of c in L1.
+  const int gemm_rows = GemmRows();
+  const int gemm_cols = GemmCols();
+  ParallelFor(0, m, GrainFor(2L * n * k), [&](int lo, int hi) {
+    for (int i = lo; i < hi; ++i) {
+      double* row = c[i];
+      if (beta == 0) {
+        std::fill(row, row + n, 0.0);
+      } else if (beta != 1) {
+        for (int j = 0; j < n; ++j) row[j] *= beta;
+      }
+    }
+    if (trans_b) {
+      // Rows of b are columns of op(b): every entry of c is a contiguous
+      // dot product once the row of op(a) is gathered.
+      std::vector<double> a_row(k);
+      for (int i = lo; i < hi; ++i) {
+        for (int p = 0; p < k; ++p) {
+          a_row[p] = alpha * (trans_a ? a[p][i] : a[i][p]);
+        }
+        DotRows(a_row.data(), b, c[i], n, k);
+      }
+      return;
+    }
+    for (int i0 = lo; i0 < hi; i0 += gemm_rows) {
+      int i1 = std::min(i0 + gemm_rows, hi);
+      for (int j0 = 0; j0 < n; j0 += gemm_cols) {
+        int j1 = std::min(j0 + gemm_cols, n);
+        GemmBlock(trans_a, alpha, a, b, c, i0, i1, j0, j1, k);
+      }
+    }
+  });
+}
+
+void Gemv(bool transpose, int m, int n, double alpha, const double* const* a,
+          const double* x, double beta, double* y) {
+  if (!transpose) {
+    ParallelFor(0, m, GrainFor(2L * n), [&](int lo, int hi) {
+      for (int i = lo; i < hi; ++i) {
+        // Four partial sums break the dependency chain of the dot product.
+        const double* row = a[i];
+        double sum[4] = {0, 0, 0, 0};
+        int j = 0;
+        for (; j + 4 <= n; j += 4) {
+          for (int l = 0; l < 4; ++l) sum[l] += row[j + l] * x[j + l];
+        }
+        for (; j < n; ++j) sum[0] += row[j] * x[j];
+        double dot = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+        y[i] = beta == 0 ? alpha * dot : alpha * dot + beta * y[i];
+      }
+    });
+    return;
+  }
+  // a^T x: threads own ranges of y and stream the matching column range
+  // of every row.
+  ParallelFor(0, n, GrainFor(2L * m), [&](int lo, int hi) {
+    for (int j = lo; j < hi; ++j) y[j] = beta == 0 ? 0 : beta * y[j];
+    for (int i = 0; i < m; ++i) {
+      Axpy(hi - lo, alpha * x[i], a[i] + lo, y + lo);
+    }
+  });
+}
+
+void Ger(int m, int n, double alpha, const double* x, const double* y,
+         double** a) {
+  ParallelFor(0, m, GrainFor(2L * n), [&](int lo, int hi) {
+    for (int i = lo; i < hi; ++i) {
+      Axpy(n, alpha * x[i], y, a[i]);
+    }
+  });
+}
+
+}  // namespace s21_detail
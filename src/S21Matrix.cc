@@ -1,10 +1,59 @@
 #include "s21_matrix_oop.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_memory.h"
+#include "s21_small.h"
+#include "s21_structured.h"
+namespace {
+
+std::atomic<bool> copy_on_write{false};
+std::atomic<S21Accumulation> accumulation_policy{S21Accumulation::kFast};
+
+// Runs the body of a Try* method, reporting failed allocations of scratch
+// or result storage as kOutOfMemory. S21Matrix storage reports them as
+// std::runtime_error, the standard containers as std::bad_alloc. Without
+// exceptions an allocation failure aborts before getting here.
+template <class Body>
+S21Status Guarded(Body body) noexcept {
+#if __cpp_exceptions
+  try {
+    return body();
+  } catch (const std::bad_alloc&) {
+    return S21Status::kOutOfMemory;
+  } catch (const std::runtime_error&) {
+    return S21Status::kOutOfMemory;
+  }
+#else
+  return body();
+#endif
+}
+
+// Throws what the throwing counterpart of a Try* method reports.
+void ThrowFor(S21Status status) {
+  if (status == S21Status::kOutOfMemory) S21_THROW(std::bad_alloc());
+  if (status != S21Status::kOk) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+}
+
+}  // namespace
+
 // METHODS
 
 S21Matrix::S21Matrix(int rows, int columns) {
   this->create_matrix(rows, columns);
 }
 
+S21Matrix::S21Matrix(int rows, int columns, S21Uninitialized) {
+  this->create_matrix(rows, columns, false);
+}
+
 // Constructor with default settings
 S21Matrix::S21Matrix() { this->create_matrix(1, 1); }
 
@@ -22,58 +71,91 @@ S21Matrix::S21Matrix(const S21Matrix& other) { this->copy_matrix(other); }
 
 // Adapter for moving
 S21Matrix::S21Matrix(S21Matrix&& other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      row_capacity_(other.row_capacity_),
+      col_capacity_(other.col_capacity_),
+      matrix_(other.matrix_),
+      fingerprint_(other.fingerprint_.load(std::memory_order_relaxed)) {
   other.rows_ = 0;
   other.cols_ = 0;
+  other.row_capacity_ = 0;
+  other.col_capacity_ = 0;
   other.matrix_ = nullptr;
 }
 
 // REWRITTEN FROM THE LAST PROJECT
-void S21Matrix::create_matrix(int rows, int cols) {
+void S21Matrix::create_matrix(int rows, int cols, bool zero) {
   if (rows <= 0 || cols <= 0) {
-    throw std::invalid_argument("Invalid matrix");
-  }
-  matrix_ = new double*[rows];
-  if (!matrix_) {
-    throw std::runtime_error("Memory allocation for rows has failed");
-  }
-  for (int i = 0; i < rows; ++i) {
-    matrix_[i] = new double[cols];
-    if (!matrix_[i]) {
-      for (int j = 0; j < i; ++j) {
-        delete[] matrix_[j];
-      }
-      delete[] matrix_;
-      throw std::runtime_error("Memory allocation for columns has failed");
-    }
-
-    for (int j = 0; j < cols; ++j) {
-      matrix_[i][j] = 0;
-    }
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
+  matrix_ = s21_detail::AllocateMatrix(rows, cols, zero);
   rows_ = rows;
   cols_ = cols;
+  row_capacity_ = rows;
+  col_capacity_ = cols;
+  touch();
 }
 
 void S21Matrix::copy_matrix(const S21Matrix& other) {
   rows_ = other.rows_;
   cols_ = other.cols_;
-  this->create_matrix(other.rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
+  if (copy_on_write && !other.IsInvalid()) {
+    s21_detail::ShareMatrix(other.matrix_);
+    matrix_ = other.matrix_;
+    row_capacity_ = other.row_capacity_;
+    col_capacity_ = other.col_capacity_;
+    fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    return;
+  }
+  this->create_matrix(other.rows_, other.cols_, false);
+  if (other.col_capacity_ == cols_) {
+    std::memcpy(matrix_[0], other.matrix_[0],
+                sizeof(double) * std::size_t(rows_) * cols_);
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      std::memcpy(matrix_[i], other.matrix_[i], sizeof(double) * cols_);
     }
   }
+  fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
 }
 
-void S21Matrix::remove_matrix() {
-  if (matrix_) {
-    for (int i = 0; i < rows_; ++i) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
+// Moves the elements into a new block with the given capacity, which must
+// hold the current size.
+void S21Matrix::reallocate(int row_capacity, int col_capacity) {
+  double** block =
+      s21_detail::AllocateMatrix(row_capacity, col_capacity, false);
+  for (int i = 0; i < rows_; ++i) {
+    std::memcpy(block[i], matrix_[i], sizeof(double) * cols_);
+  }
+  remove_matrix();
+  matrix_ = block;
+  row_capacity_ = row_capacity;
+  col_capacity_ = col_capacity;
+}
+
+void S21Matrix::touch() {
+  if (matrix_ && s21_detail::IsShared(matrix_)) {
+    reallocate(row_capacity_, col_capacity_);
   }
+  fingerprint_.store(0, std::memory_order_relaxed);
+}
+
+void S21Matrix::SetCopyOnWrite(bool enabled) { copy_on_write = enabled; }
+bool S21Matrix::GetCopyOnWrite() { return copy_on_write; }
+
+void S21Matrix::SetAccumulation(S21Accumulation accumulation) {
+  accumulation_policy = accumulation;
+}
+
+S21Accumulation S21Matrix::GetAccumulation() { return accumulation_policy; }
+
+void S21Matrix::remove_matrix() {
+  s21_detail::FreeMatrix(matrix_);
   matrix_ = nullptr;
+  touch();
 }
 
 // ACCESS METHODS
@@ -81,31 +163,75 @@ int S21Matrix::GetRows() const { return rows_; }
 int S21Matrix::GetCols() const { return cols_; }
 
 void S21Matrix::SetRows(int rows) {
-  if (rows != rows_) {
-    S21Matrix temp(rows, cols_);
-    int min_rows = std::min(rows, rows_);
-    for (int i = 0; i < min_rows; i++) {
-      for (int j = 0; j < cols_; ++j) {
-        temp.matrix_[i][j] = matrix_[i][j];
-      }
-    }
-    *this = std::move(temp);
+  if (rows <= 0 || IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
+  if (rows > row_capacity_) reallocate(rows, col_capacity_);
+  touch();
+  for (int i = rows_; i < rows; ++i) {
+    std::fill(matrix_[i], matrix_[i] + cols_, 0.0);
+  }
+  rows_ = rows;
 }
 
 void S21Matrix::SetCols(int cols) {
-  if (cols != cols_) {
-    S21Matrix temp(rows_, cols);
-    int min_cols = std::min(cols, cols_);
+  if (cols <= 0 || IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (cols > col_capacity_) reallocate(row_capacity_, cols);
+  touch();
+  if (cols > cols_) {
     for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < min_cols; j++) {
-        temp.matrix_[i][j] = matrix_[i][j];
-      }
+      std::fill(matrix_[i] + cols_, matrix_[i] + cols, 0.0);
     }
-    *this = std::move(temp);
   }
+  cols_ = cols;
+}
+
+void S21Matrix::Reserve(int rows, int cols) {
+  if (IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (rows > row_capacity_ || cols > col_capacity_) {
+    reallocate(std::max(rows, row_capacity_), std::max(cols, col_capacity_));
+  }
+}
+
+void S21Matrix::AppendRow(const S21Matrix& row) {
+  if (IsInvalid() || row.IsInvalid() || row.rows_ != 1 ||
+      row.cols_ != cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (rows_ == row_capacity_) {
+    reallocate(std::max(2 * row_capacity_, 4), col_capacity_);
+  }
+  touch();
+  std::memcpy(matrix_[rows_], row.matrix_[0], sizeof(double) * cols_);
+  ++rows_;
 }
 
+void S21Matrix::AppendCol(const S21Matrix& col) {
+  if (IsInvalid() || col.IsInvalid() || col.cols_ != 1 ||
+      col.rows_ != rows_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (cols_ == col_capacity_) {
+    reallocate(row_capacity_, std::max(2 * col_capacity_, 4));
+  }
+  touch();
+  for (int i = 0; i < rows_; ++i) matrix_[i][cols_] = col.matrix_[i][0];
+  ++cols_;
+}
+
+void S21Matrix::ShrinkToFit() {
+  if (!IsInvalid() && (rows_ != row_capacity_ || cols_ != col_capacity_)) {
+    reallocate(rows_, cols_);
+  }
+}
+
+int S21Matrix::GetRowCapacity() const { return row_capacity_; }
+int S21Matrix::GetColCapacity() const { return col_capacity_; }
+
 // OPERATORS
 
 S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
@@ -121,9 +247,7 @@ S21Matrix S21Matrix::operator-(const S21Matrix& other) const {
 }
 
 S21Matrix S21Matrix::operator*(const S21Matrix& other) const {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
-  return result;
+  return product(other);
 }
 
 S21Matrix S21Matrix::operator*(const double num) const {
@@ -146,9 +270,15 @@ S21Matrix& S21Matrix::operator=(S21Matrix&& other) {
     matrix_ = other.matrix_;
     rows_ = other.rows_;
     cols_ = other.cols_;
+    row_capacity_ = other.row_capacity_;
+    col_capacity_ = other.col_capacity_;
+    fingerprint_.store(other.fingerprint_.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
 
     other.rows_ = 0;
     other.cols_ = 0;
+    other.row_capacity_ = 0;
+    other.col_capacity_ = 0;
     other.matrix_ = nullptr;
   }
   return *this;
@@ -180,14 +310,15 @@ bool S21Matrix::operator==(const S21Matrix& other) const {
 
 double& S21Matrix::operator()(int row, int col) {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
-    throw std::invalid_argument("Invalid argument");
+    S21_THROW(std::invalid_argument("Invalid argument"));
   }
+  touch();
   return matrix_[row][col];
 }
 
 const double& S21Matrix::operator()(int row, int col) const {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
-    throw std::invalid_argument("Invalid argument");
+    S21_THROW(std::invalid_argument("Invalid argument"));
   }
   return matrix_[row][col];
 }
@@ -199,20 +330,62 @@ bool S21Matrix::IsInvalid() const {
 }
 
 void S21Matrix::MulMatrix(const S21Matrix& other) {
+  *this = product(other);
+}
+
+S21Matrix S21Matrix::product(const S21Matrix& other) const {
   if (this->cols_ != other.rows_) {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  S21Matrix result(this->rows_, other.cols_, kS21Uninitialized);
+  S21Accumulation accumulation = GetAccumulation();
+  if (accumulation == S21Accumulation::kFast && rows_ == cols_ &&
+      other.rows_ == other.cols_ &&
+      s21_detail::SmallMultiply(rows_, matrix_, other.matrix_,
+                                result.matrix_)) {
+    return result;
   }
-  S21Matrix result(this->rows_, other.cols_);
+  // Row vector times matrix and matrix times column vector go through GEMV.
+  if (accumulation == S21Accumulation::kFast && rows_ == 1) {
+    s21_detail::Gemv(true, other.rows_, other.cols_, 1, other.matrix_,
+                     matrix_[0], 0, result.matrix_[0]);
+    return result;
+  }
+  if (accumulation == S21Accumulation::kFast && other.cols_ == 1) {
+    std::vector<double> x(cols_), y(rows_);
+    for (int j = 0; j < cols_; j++) x[j] = other.matrix_[j][0];
+    s21_detail::Gemv(false, rows_, cols_, 1, matrix_, x.data(), 0, y.data());
+    for (int i = 0; i < rows_; i++) result.matrix_[i][0] = y[i];
+    return result;
+  }
+  s21_detail::Gemm(false, false, rows_, other.cols_, cols_, 1, matrix_,
+                   other.matrix_, 0, result.matrix_, accumulation);
+  return result;
+}
 
-  for (int k = 0; k < this->rows_; k++) {
-    for (int i = 0; i < other.cols_; i++) {
-      result.matrix_[k][i] = 0;
-      for (int j = 0; j < this->cols_; j++) {
-        result.matrix_[k][i] += this->matrix_[k][j] * other.matrix_[j][i];
-      }
-    }
+void S21Matrix::Gemm(bool trans_a, bool trans_b, double alpha,
+                     const S21Matrix& a, const S21Matrix& b, double beta,
+                     S21Matrix* c) {
+  if (c == nullptr || a.IsInvalid() || b.IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
-  this->copy_matrix(result);
+  int m = trans_a ? a.cols_ : a.rows_;
+  int k = trans_a ? a.rows_ : a.cols_;
+  int n = trans_b ? b.rows_ : b.cols_;
+  bool fits = c->rows_ == m && c->cols_ == n && !c->IsInvalid();
+  if ((trans_b ? b.cols_ : b.rows_) != k || (beta != 0 && !fits)) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (c == &a || c == &b) {
+    S21Matrix result = beta == 0 ? S21Matrix(m, n, kS21Uninitialized) : *c;
+    Gemm(trans_a, trans_b, alpha, a, b, beta, &result);
+    *c = std::move(result);
+    return;
+  }
+  if (!fits) *c = S21Matrix(m, n, kS21Uninitialized);
+  c->touch();
+  s21_detail::Gemm(trans_a, trans_b, m, n, k, alpha, a.matrix_, b.matrix_,
+                   beta, c->matrix_, GetAccumulation());
 }
 
 int S21Matrix::CheckMatrices(const S21Matrix& other) const {
@@ -224,8 +397,9 @@ int S21Matrix::CheckMatrices(const S21Matrix& other) const {
 
 void S21Matrix::SumMatrix(const S21Matrix& other) {
   if (CheckMatrices(other) != 0) {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
+  touch();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       this->matrix_[i][j] += other.matrix_[i][j];
@@ -235,8 +409,9 @@ void S21Matrix::SumMatrix(const S21Matrix& other) {
 
 void S21Matrix::SubMatrix(const S21Matrix& other) {
   if (CheckMatrices(other) != 0) {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
+  touch();
 
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
@@ -248,20 +423,13 @@ void S21Matrix::SubMatrix(const S21Matrix& other) {
 bool S21Matrix::EqMatrix(const S21Matrix& other) const {
   if (this->rows_ != other.rows_ || this->cols_ != other.cols_ ||
       this->IsInvalid() || other.IsInvalid()) {
-    throw std::invalid_argument("Invalid matrix");
-  }
-
-  for (int i = 0; i < this->rows_; ++i) {
-    for (int j = 0; j < this->cols_; ++j) {
-      if (std::fabs(this->matrix_[i][j] - other.matrix_[i][j]) >= 1e-07) {
-        return false;
-      }
-    }
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
-  return true;
+  return all_close(other, S21Tolerance());
 }
 
 void S21Matrix::MulNumber(const double num) {
+  touch();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] *= num;
@@ -271,7 +439,11 @@ void S21Matrix::MulNumber(const double num) {
 
 S21Matrix S21Matrix::Transpose() const {
   if (!this->IsInvalid()) {
-    S21Matrix result(this->cols_, this->rows_);
+    S21Matrix result(this->cols_, this->rows_, kS21Uninitialized);
+    if (rows_ == cols_ &&
+        s21_detail::SmallTranspose(rows_, matrix_, result.matrix_)) {
+      return result;
+    }
     for (int i = 0; i < this->rows_; i += 1) {
       for (int j = 0; j < this->cols_; j += 1) {
         result.matrix_[j][i] = this->matrix_[i][j];
@@ -279,10 +451,36 @@ S21Matrix S21Matrix::Transpose() const {
     }
     return result;
   } else {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
 }
 
+S21Structure S21Matrix::DetectStructure(int* lower, int* upper) const {
+  if (this->IsInvalid() || this->rows_ != this->cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int low = 0, up = 0;
+  bool symmetric = true;
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      if (matrix_[i][j] != 0) {
+        low = std::max(low, i - j);
+        up = std::max(up, j - i);
+      }
+      if (j < i && matrix_[i][j] != matrix_[j][i]) symmetric = false;
+    }
+  }
+  if (lower) *lower = low;
+  if (upper) *upper = up;
+  if (low == 0 && up == 0) return S21Structure::kDiagonal;
+  if (low == 0) return S21Structure::kUpperTriangular;
+  if (up == 0) return S21Structure::kLowerTriangular;
+  // Band storage with pivoting room only pays off while narrower than a row.
+  if (2 * low + up + 1 < rows_) return S21Structure::kBanded;
+  if (symmetric) return S21Structure::kSymmetric;
+  return S21Structure::kGeneral;
+}
+
 void S21Matrix::get_minor(int skip_row, int skip_col,
                           const S21Matrix& minor) const {
   int dimension = this->rows_;
@@ -303,25 +501,31 @@ void S21Matrix::get_minor(int skip_row, int skip_col,
 double S21Matrix::Determinant() const {
   double result = 0.0;
   if ((this->IsInvalid()) || (this->rows_ != this->cols_)) {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (s21_detail::SmallDeterminant(rows_, matrix_, &result)) {
+    return result;
   } else {
-    if (this->rows_ == 1) {
-      result = this->matrix_[0][0];
+    int lower = 0, upper = 0;
+    S21Structure structure = DetectStructure(&lower, &upper);
+    if (structure != S21Structure::kGeneral &&
+        structure != S21Structure::kSymmetric) {
+      return S21StructuredMatrix(*this, structure, lower, upper)
+          .Determinant();
     }
-    if (this->rows_ == 2) {
-      result = this->matrix_[0][0] * this->matrix_[1][1] -
-               this->matrix_[0][1] * this->matrix_[1][0];
+    S21Matrix factor(*this);
+    factor.touch();
+    if (structure == S21Structure::kSymmetric &&
+        s21_detail::CholeskyFactor(factor.matrix_, rows_, &result)) {
+      return result;
     }
-  }
-  if (this->rows_ > 2) {
-    for (int f = 0; f < this->rows_; f++) {
-      S21Matrix minor(this->rows_ - 1, this->cols_ - 1);
-      this->get_minor(0, f, minor);
-      double pre_result = 0;
-      pre_result = minor.Determinant();
-      result += (this->matrix_[0][f] * pre_result * (f % 2 == 0 ? 1 : -1));
-      minor.~S21Matrix();
+    // CholeskyFactor may have overwritten the lower triangle.
+    if (structure == S21Structure::kSymmetric) {
+      factor = *this;
+      factor.touch();
     }
+    std::vector<int> pivots(rows_);
+    result = s21_detail::LuFactor(factor.matrix_, rows_, pivots.data());
   }
   return result;
 }
@@ -329,14 +533,14 @@ double S21Matrix::Determinant() const {
 S21Matrix S21Matrix::CalcComplements() const {
   int sign;
   if (this->IsInvalid()) {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
   if (this->rows_ != this->cols_) {
-    throw std::invalid_argument("Invalid matrix");
+    S21_THROW(std::invalid_argument("Invalid matrix"));
   }
   double determinant = 0;
 
-  S21Matrix result(this->rows_, this->cols_);
+  S21Matrix result(this->rows_, this->cols_, kS21Uninitialized);
   if (this->rows_ != 1) {
     S21Matrix minor(this->rows_ - 1, this->cols_ - 1);
     for (int i = 0; i < this->rows_; i += 1) {
@@ -356,26 +560,101 @@ S21Matrix S21Matrix::CalcComplements() const {
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  if (this->IsInvalid() || this->cols_ != this->rows_) {
-    throw std::invalid_argument("Invalid matrix");
+S21Matrix S21Matrix::InverseMatrix() const {
+  S21Matrix result;
+  ThrowFor(TryInverse(&result));
+  return result;
+}
+
+S21Matrix S21Matrix::Solve(const S21Matrix& b) const {
+  S21Matrix x;
+  ThrowFor(TrySolve(b, &x));
+  return x;
+}
+
+S21Status S21Matrix::TryInverse(S21Matrix* result) const noexcept {
+  if (result == nullptr || this->IsInvalid() || this->cols_ != this->rows_) {
+    return S21Status::kInvalidMatrix;
   }
-  double determinant = this->Determinant();
-  if (fabs(determinant) < 1e-6) {
-    throw std::invalid_argument("Invalid matrix");
+  return Guarded([&] { return invert(result); });
+}
+
+S21Status S21Matrix::invert(S21Matrix* result) const {
+  S21Matrix inverse(this->rows_, this->cols_, kS21Uninitialized);
+  double determinant = 0;
+  // Symmetric input is tried as SPD first: Cholesky does half the work of
+  // LU and gives an exactly symmetric inverse. Up to 3x3 the adjugate
+  // formulas are already symmetric. Larger matrices are checked by
+  // DetectStructure, so that banded ones keep the band solver.
+  S21Structure structure = S21Structure::kGeneral;
+  int lower = 0, upper = 0;
+  if (rows_ > s21_detail::SmallLimit()) {
+    structure = DetectStructure(&lower, &upper);
+  } else if (rows_ > 3) {
+    structure = S21Structure::kSymmetric;
+    for (int i = 1; i < rows_ && structure == S21Structure::kSymmetric; i++) {
+      for (int j = 0; j < i; j++) {
+        if (matrix_[i][j] != matrix_[j][i]) structure = S21Structure::kGeneral;
+      }
+    }
   }
-  if (this->rows_ == 1) {
-    S21Matrix result(1, 1);
-    result.matrix_[0][0] = 1.0 / this->matrix_[0][0];
-    return result;
+  bool spd = false;
+  if (structure == S21Structure::kSymmetric) {
+    S21Matrix factor(*this);
+    factor.touch();
+    spd = s21_detail::CholeskyFactor(factor.matrix_, rows_, &determinant);
+    if (spd && !(fabs(determinant) < 1e-6)) {
+      s21_detail::CholeskyInverse(factor.matrix_, rows_, inverse.matrix_);
+    }
   }
-  S21Matrix result(this->rows_, this->cols_);
-  S21Matrix transposed_m = this->Transpose();
-  S21Matrix adj_m = transposed_m.CalcComplements();
-  for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < this->cols_; j++) {
-      result.matrix_[i][j] = adj_m.matrix_[i][j] * (1 / determinant);
+  if (!spd && !s21_detail::SmallInverse(rows_, matrix_, inverse.matrix_,
+                                        &determinant)) {
+    if (structure != S21Structure::kGeneral &&
+        structure != S21Structure::kSymmetric) {
+      S21StructuredMatrix structured(*this, structure, lower, upper);
+      determinant = structured.Invert(&inverse);
+    } else {
+      S21Matrix lu(*this);
+      lu.touch();
+      std::vector<int> pivots(rows_);
+      determinant = s21_detail::LuFactor(lu.matrix_, rows_, pivots.data());
+      if (!(fabs(determinant) < 1e-6)) {
+        s21_detail::LuInverse(lu.matrix_, rows_, pivots.data(),
+                              inverse.matrix_);
+      }
     }
   }
-  return result;
+  if (!(fabs(determinant) >= 1e-6)) return S21Status::kSingular;
+  *result = std::move(inverse);
+  return S21Status::kOk;
+}
+
+S21Status S21Matrix::TrySolve(const S21Matrix& b, S21Matrix* x) const noexcept {
+  if (x == nullptr || IsInvalid() || b.IsInvalid() || rows_ != cols_ ||
+      b.rows_ != rows_) {
+    return S21Status::kInvalidMatrix;
+  }
+  return Guarded([&] {
+    S21Matrix lu(*this), solution(b);
+    lu.touch();
+    solution.touch();
+    std::vector<int> pivots(rows_);
+    double determinant =
+        s21_detail::LuFactor(lu.matrix_, rows_, pivots.data());
+    if (fabs(determinant) < 1e-6) return S21Status::kSingular;
+    s21_detail::LuSolve(lu.matrix_, rows_, pivots.data(), solution.matrix_,
+                        b.cols_);
+    *x = std::move(solution);
+    return S21Status::kOk;
+  });
+}
+
+S21Status S21Matrix::TryDeterminant(double* result) const noexcept {
+  if (result == nullptr || IsInvalid() || rows_ != cols_) {
+    return S21Status::kInvalidMatrix;
+  }
+  return Guarded([&] {
+    *result = Determinant();
+    return S21Status::kOk;
+  });
 }
@@ -0,0 +1,149 @@
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+#include "s21_memory.h"
+#include "s21_numa.h"
+#include "s21_parallel.h"
+
+namespace {
+
+const std::size_t kAlignment = 64;
+
+enum BlockKind { kHeap, kMapped };
+
+std::size_t PageSize() {
+  static const std::size_t size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+std::uintptr_t AlignUp(std::uintptr_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+#ifdef __linux__
+const int kBindMode = MPOL_BIND;
+const int kInterleaveMode = MPOL_INTERLEAVE;
+
+// Raw syscall so that no libnuma is needed at link time. Failures (one
+// node, no permission) leave the default first-touch placement.
+void Bind(void* start, std::size_t bytes, int mode, unsigned long mask) {
+  if (bytes == 0) return;
+  syscall(SYS_mbind, start, bytes, mode, &mask, sizeof(mask) * 8, 0);
+}
+#else
+// No mbind elsewhere: every policy falls back to first-touch placement.
+const int kBindMode = 0;
+const int kInterleaveMode = 0;
+
+void Bind(void*, std::size_t, int, unsigned long) {}
+#endif
+
+unsigned long AllNodesMask(int nodes) {
+  return nodes >= 64 ? ~0UL : (1UL << nodes) - 1;
+}
+
+}  // namespace
+
+namespace s21_detail {
+
+double** AllocateMatrix(int rows, int cols, bool zero) {
+  std::size_t table = AlignUp(sizeof(BlockHeader) + rows * sizeof(double*),
+                              kAlignment);
+  std::size_t data_bytes = std::size_t(rows) * cols * sizeof(double);
+  std::size_t bytes = table + kAlignment + data_bytes;
+
+  S21NumaPolicy policy = S21Numa::GetPolicy();
+  if (bytes < S21Numa::GetMinBytes()) policy = S21NumaPolicy::kDefault;
+  BlockKind kind = kHeap;
+  void* base = nullptr;
+  if (policy != S21NumaPolicy::kDefault) {
+    base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+      base = nullptr;
+    } else {
+      kind = kMapped;
+    }
+  }
+  if (!base) {
+    policy = S21NumaPolicy::kDefault;
+    // calloc hands large blocks out as fresh zero pages, so zeroing there
+    // costs no extra pass.
+    base = zero ? std::calloc(bytes, 1) : std::malloc(bytes);
+  }
+  if (!base) {
+    S21_THROW(std::runtime_error("Memory allocation for matrix has failed"));
+  }
+
+  std::uintptr_t start = reinterpret_cast<std::uintptr_t>(base);
+  BlockHeader* header = reinterpret_cast<BlockHeader*>(
+      AlignUp(start + table, kAlignment) - rows * sizeof(double*) -
+      sizeof(BlockHeader));
+  double** matrix = reinterpret_cast<double**>(header + 1);
+  double* data = reinterpret_cast<double*>(AlignUp(start + table, kAlignment));
+
+  // The policy is applied before anything is written, so that no page is
+  // faulted in on the allocating thread's node first.
+  int nodes = S21Numa::NodeCount();
+  if (policy == S21NumaPolicy::kInterleave) {
+    Bind(base, bytes, kInterleaveMode, AllNodesMask(nodes));
+  } else if (policy == S21NumaPolicy::kNodeLocalTiles) {
+    std::uintptr_t page = PageSize();
+    std::uintptr_t tile_start = start;
+    for (int node = 0; node < nodes; ++node) {
+      long last_row = 1L * rows * (node + 1) / nodes;
+      std::uintptr_t tile_end =
+          node + 1 == nodes
+              ? start + bytes
+              : reinterpret_cast<std::uintptr_t>(data + last_row * cols) /
+                    page * page;
+      if (tile_end > tile_start) {
+        Bind(reinterpret_cast<void*>(tile_start), tile_end - tile_start,
+             kBindMode, 1UL << (node % 64));
+        tile_start = tile_end;
+      }
+    }
+  }
+
+  new (header) BlockHeader();
+  header->base = base;
+  header->bytes = bytes;
+  header->refs.store(1, std::memory_order_relaxed);
+  header->kind = kind;
+  for (int i = 0; i < rows; ++i) matrix[i] = data + std::size_t(i) * cols;
+  if (policy == S21NumaPolicy::kParallelFirstTouch) {
+    // Same row split as the parallel kernels use.
+    ParallelFor(0, rows, GrainFor(cols), [&](int lo, int hi) {
+      std::memset(matrix[lo], 0, std::size_t(hi - lo) * cols * sizeof(double));
+    });
+  }
+  return matrix;
+}
+
+void FreeMatrix(double** matrix) {
+  if (!matrix) return;
+  BlockHeader* header = HeaderOf(matrix);
+  if (header->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  void* base = header->base;
+  std::size_t bytes = header->bytes;
+  int kind = header->kind;
+  header->~BlockHeader();
+  if (kind == kMapped) {
+    munmap(base, bytes);
+  } else {
+    std::free(base);
+  }
+}
+
+}  // namespace s21_detail
@@ -0,0 +1,119 @@
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "s21_numa.h"
+#include "s21_parallel.h"
+
+namespace {
+
+std::atomic<S21NumaPolicy> policy{S21NumaPolicy::kDefault};
+std::atomic<std::size_t> min_bytes{std::size_t(1) << 22};
+std::atomic<bool> pinning{false};
+
+// Parses sysfs lists such as "0-3,8,10-11".
+std::vector<int> ParseCpuList(const std::string& text) {
+  std::vector<int> result;
+  std::stringstream stream(text);
+  std::string part;
+  while (std::getline(stream, part, ',')) {
+    if (part.empty()) continue;
+    std::size_t dash = part.find('-');
+    int first = std::stoi(part.substr(0, dash));
+    int last = first;
+    if (dash != std::string::npos) last = std::stoi(part.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+  return result;
+}
+
+std::string ReadLine(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+#ifdef __linux__
+// Online CPUs ordered node by node.
+const std::vector<int>& CpuOrder() {
+  static const std::vector<int> order = [] {
+    std::vector<int> cpus;
+    for (int node = 0; node < S21Numa::NodeCount(); ++node) {
+      std::string list = ReadLine("/sys/devices/system/node/node" +
+                                  std::to_string(node) + "/cpulist");
+      for (int cpu : ParseCpuList(list)) cpus.push_back(cpu);
+    }
+    if (cpus.empty()) {
+      for (int cpu = 0; cpu < s21_detail::WorkerCount(); ++cpu) {
+        cpus.push_back(cpu);
+      }
+    }
+    return cpus;
+  }();
+  return order;
+}
+#endif
+
+}  // namespace
+
+void S21Numa::SetPolicy(S21NumaPolicy value) { policy = value; }
+S21NumaPolicy S21Numa::GetPolicy() { return policy; }
+void S21Numa::SetMinBytes(std::size_t bytes) { min_bytes = bytes; }
+std::size_t S21Numa::GetMinBytes() { return min_bytes; }
+void S21Numa::SetThreadPinning(bool enabled) { pinning = enabled; }
+bool S21Numa::GetThreadPinning() { return pinning; }
+
+int S21Numa::NodeCount() {
+  static const int count = [] {
+    std::vector<int> nodes =
+        ParseCpuList(ReadLine("/sys/devices/system/node/online"));
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return count;
+}
+
+namespace s21_detail {
+
+#ifdef __linux__
+void PinWorker(int worker) {
+  if (!pinning) return;
+  const std::vector<int>& cpus = CpuOrder();
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpus[worker % cpus.size()], &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+CallerPin::CallerPin() {
+  if (!pinning) return;
+  cpu_set_t set;
+  static_assert(sizeof(set) <= sizeof(saved_), "cpu_set_t does not fit");
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) return;
+  std::memcpy(saved_, &set, sizeof(set));
+  pinned_ = true;
+  PinWorker(0);
+}
+
+CallerPin::~CallerPin() {
+  if (!pinned_) return;
+  cpu_set_t set;
+  std::memcpy(&set, saved_, sizeof(set));
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+#else
+// Thread affinity is not portable; the setting is kept but has no effect.
+void PinWorker(int) {}
+CallerPin::CallerPin() {}
+CallerPin::~CallerPin() {}
+#endif
+
+}  // namespace s21_detail
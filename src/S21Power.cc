@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_matrix_oop.h"
+
+// POWER AND EXPONENTIAL
+
+namespace {
+
+// Coefficients b_0..b_m of the [m/m] Pade approximant of exp, and the
+// largest 1-norm for which it is accurate to double precision without
+// scaling (Higham, "The scaling and squaring method for the matrix
+// exponential revisited", 2005).
+const double kPade3[] = {120, 60, 12, 1};
+const double kPade5[] = {30240, 15120, 3360, 420, 30, 1};
+const double kPade7[] = {17297280, 8648640, 1995840, 277200,
+                         25200,    1512,    56,      1};
+const double kPade9[] = {17643225600, 8821612800, 2075673600, 302702400,
+                         30270240,    2162160,    110880,     3960,
+                         90,          1};
+const double kPade13[] = {64764752532480000, 32382376266240000,
+                          7771770303897600,  1187353796428800,
+                          129060195264000,   10559470521600,
+                          670442572800,      33522128640,
+                          1323241920,        40840800,
+                          960960,            16380,
+                          182,               1};
+
+struct Pade {
+  int degree;
+  double theta;
+  const double* b;
+};
+
+const Pade kPade[] = {{3, 1.495585217958292e-2, kPade3},
+                      {5, 2.539398330063230e-1, kPade5},
+                      {7, 9.504178996162932e-1, kPade7},
+                      {9, 2.097847961257068e+0, kPade9},
+                      {13, 5.371920351148152e+0, kPade13}};
+
+// out = (accumulate ? out : 0) + identity * I + sum of weights[t] * terms[t].
+void Combine(double** out, int n, bool accumulate, double identity,
+             const double* weights, double** const* terms, int count) {
+  for (int i = 0; i < n; ++i) {
+    double* row = out[i];
+    if (!accumulate) std::fill(row, row + n, 0.0);
+    for (int t = 0; t < count; ++t) {
+      const double* term = terms[t][i];
+      for (int j = 0; j < n; ++j) row[j] += weights[t] * term[j];
+    }
+    row[i] += identity;
+  }
+}
+
+}  // namespace
+
+S21Matrix S21Matrix::Power(int k) const {
+  if (IsInvalid() || rows_ != cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int n = rows_;
+  auto multiply = [n](const S21Matrix& a, const S21Matrix& b, S21Matrix& out) {
+    out.touch();
+    s21_detail::Multiply(a.matrix_, b.matrix_, out.matrix_, n, n, n);
+  };
+  unsigned exponent =
+      k < 0 ? 0u - static_cast<unsigned>(k) : static_cast<unsigned>(k);
+  if (exponent == 0) {
+    S21Matrix identity(n, n);
+    for (int i = 0; i < n; ++i) identity.matrix_[i][i] = 1;
+    return identity;
+  }
+  S21Matrix base = k < 0 ? InverseMatrix() : *this;
+  // The three buffers are reused for every product: each step writes into
+  // scratch and swaps it with its destination.
+  S21Matrix scratch(n, n, kS21Uninitialized);
+  for (; !(exponent & 1); exponent >>= 1) {
+    multiply(base, base, scratch);
+    std::swap(base, scratch);
+  }
+  S21Matrix result(base);
+  while (exponent >>= 1) {
+    multiply(base, base, scratch);
+    std::swap(base, scratch);
+    if (exponent & 1) {
+      multiply(result, base, scratch);
+      std::swap(result, scratch);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21Matrix::Exp() const {
+  if (IsInvalid() || rows_ != cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int n = rows_;
+  auto multiply = [n](const S21Matrix& a, const S21Matrix& b, S21Matrix& out) {
+    out.touch();
+    s21_detail::Multiply(a.matrix_, b.matrix_, out.matrix_, n, n, n);
+  };
+  double norm = OneNorm();
+  if (!std::isfinite(norm)) S21_THROW(std::invalid_argument("Invalid matrix"));
+
+  // The cheapest approximant accurate for this norm; past the last one
+  // the matrix is scaled by 2^-squarings and the result squared back.
+  const Pade* pade = kPade;
+  while (pade->degree < 13 && norm > pade->theta) ++pade;
+  int squarings = 0;
+  if (norm > pade->theta) {
+    squarings = static_cast<int>(std::ceil(std::log2(norm / pade->theta)));
+  }
+  S21Matrix a(*this);
+  if (squarings > 0) a.MulNumber(std::ldexp(1.0, -squarings));
+
+  // Even powers A^2, A^4, ... up to what the approximant needs.
+  int power_count = pade->degree == 13 ? 3 : pade->degree / 2;
+  S21Matrix powers[4];
+  double** terms[4];
+  for (int p = 0; p < power_count; ++p) {
+    powers[p] = S21Matrix(n, n, kS21Uninitialized);
+    if (p == 0) {
+      multiply(a, a, powers[0]);
+    } else if (p == 3) {
+      multiply(powers[1], powers[1], powers[3]);
+    } else {
+      multiply(powers[p - 1], powers[0], powers[p]);
+    }
+    terms[p] = powers[p].matrix_;
+  }
+
+  // exp(A) ~ (V - U)^-1 (V + U) with U holding the odd and V the even
+  // terms of the numerator polynomial.
+  const double* b = pade->b;
+  S21Matrix u(n, n, kS21Uninitialized);
+  S21Matrix v(n, n, kS21Uninitialized);
+  S21Matrix inner(n, n, kS21Uninitialized);
+  S21Matrix scratch(n, n, kS21Uninitialized);
+  if (pade->degree == 13) {
+    const double high_odd[] = {b[9], b[11], b[13]};
+    const double low_odd[] = {b[3], b[5], b[7]};
+    const double high_even[] = {b[8], b[10], b[12]};
+    const double low_even[] = {b[2], b[4], b[6]};
+    Combine(scratch.matrix_, n, false, 0, high_odd, terms, 3);
+    multiply(powers[2], scratch, inner);
+    Combine(inner.matrix_, n, true, b[1], low_odd, terms, 3);
+    multiply(a, inner, u);
+    Combine(scratch.matrix_, n, false, 0, high_even, terms, 3);
+    multiply(powers[2], scratch, v);
+    Combine(v.matrix_, n, true, b[0], low_even, terms, 3);
+  } else {
+    double odd[4], even[4];
+    for (int p = 0; p < power_count; ++p) {
+      odd[p] = b[2 * p + 3];
+      even[p] = b[2 * p + 2];
+    }
+    Combine(inner.matrix_, n, false, b[1], odd, terms, power_count);
+    multiply(a, inner, u);
+    Combine(v.matrix_, n, false, b[0], even, terms, power_count);
+  }
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double odd_part = u.matrix_[i][j];
+      u.matrix_[i][j] = v.matrix_[i][j] + odd_part;
+      v.matrix_[i][j] -= odd_part;
+    }
+  }
+  std::vector<int> pivots(n);
+  if (s21_detail::LuFactor(v.matrix_, n, pivots.data()) == 0) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  s21_detail::LuSolve(v.matrix_, n, pivots.data(), u.matrix_, n);
+
+  for (int s = 0; s < squarings; ++s) {
+    multiply(u, u, scratch);
+    std::swap(u, scratch);
+  }
+  return u;
+}
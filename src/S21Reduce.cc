@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+// REDUCTIONS AND NORMS
+
+namespace {
+
+const int kPairwiseBlock = 128;
+const int kLanes = 8;
+
+// Pairwise sum of term(0) .. term(n - 1): the rounding error grows with
+// log(n) rather than n. The base case keeps kLanes independent partial
+// sums so that it vectorizes.
+template <class Term>
+double PairwiseSum(int begin, int end, const Term& term) {
+  int n = end - begin;
+  if (n > kPairwiseBlock) {
+    int middle = begin + n / 2;
+    return PairwiseSum(begin, middle, term) + PairwiseSum(middle, end, term);
+  }
+  double lanes[kLanes] = {};
+  int i = begin;
+  for (; i + kLanes <= end; i += kLanes) {
+    for (int l = 0; l < kLanes; ++l) lanes[l] += term(i + l);
+  }
+  for (int l = 0; i < end; ++i, ++l) lanes[l] += term(i);
+  return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+// Evaluates row_value(i) for every row in parallel.
+template <class RowValue>
+std::vector<double> PerRow(int rows, int cols, const RowValue& row_value) {
+  std::vector<double> values(rows);
+  s21_detail::ParallelFor(0, rows, s21_detail::GrainFor(cols),
+                          [&](int lo, int hi) {
+                            for (int i = lo; i < hi; ++i) {
+                              values[i] = row_value(i);
+                            }
+                          });
+  return values;
+}
+
+template <class RowValue>
+double SumRows(int rows, int cols, const RowValue& row_value) {
+  std::vector<double> values = PerRow(rows, cols, row_value);
+  return PairwiseSum(0, rows, [&values](int i) { return values[i]; });
+}
+
+// Column sums of map(a[i][j]) with Neumaier compensation. Threads take
+// column ranges, so every inner loop runs along a contiguous row.
+template <class Map>
+std::vector<double> ColumnSums(double* const* a, int rows, int cols,
+                               const Map& map) {
+  std::vector<double> sums(cols), carry(cols);
+  s21_detail::ParallelFor(0, cols, s21_detail::GrainFor(rows),
+                          [&](int lo, int hi) {
+                            for (int i = 0; i < rows; ++i) {
+                              const double* row = a[i];
+                              for (int j = lo; j < hi; ++j) {
+                                double x = map(row[j]);
+                                double s = sums[j];
+                                double t = s + x;
+                                carry[j] += std::fabs(s) >= std::fabs(x)
+                                                ? (s - t) + x
+                                                : (x - t) + s;
+                                sums[j] = t;
+                              }
+                            }
+                          });
+  for (int j = 0; j < cols; ++j) sums[j] += carry[j];
+  return sums;
+}
+
+double Absolute(double x) { return std::fabs(x); }
+double Identity(double x) { return x; }
+
+double Norm2(const std::vector<double>& x) {
+  double scale = 0;
+  for (double value : x) scale = std::max(scale, std::fabs(value));
+  if (scale == 0) return 0;
+  double sum = PairwiseSum(0, static_cast<int>(x.size()), [&](int i) {
+    double scaled = x[i] / scale;
+    return scaled * scaled;
+  });
+  return scale * std::sqrt(sum);
+}
+
+}  // namespace
+
+double S21Matrix::Sum() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  return SumRows(rows_, cols_, [this](int i) {
+    const double* row = matrix_[i];
+    return PairwiseSum(0, cols_, [row](int j) { return row[j]; });
+  });
+}
+
+double S21Matrix::Trace() const {
+  if (IsInvalid() || rows_ != cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  return PairwiseSum(0, rows_, [this](int i) { return matrix_[i][i]; });
+}
+
+double S21Matrix::Dot(const S21Matrix& other) const {
+  if (CheckMatrices(other) != 0) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  return SumRows(rows_, cols_, [this, &other](int i) {
+    const double* row = matrix_[i];
+    const double* other_row = other.matrix_[i];
+    return PairwiseSum(
+        0, cols_, [row, other_row](int j) { return row[j] * other_row[j]; });
+  });
+}
+
+double S21Matrix::MaxAbs() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  std::vector<double> maxima = PerRow(rows_, cols_, [this](int i) {
+    const double* row = matrix_[i];
+    double result = 0;
+    for (int j = 0; j < cols_; ++j) {
+      result = std::max(result, std::fabs(row[j]));
+    }
+    return result;
+  });
+  return *std::max_element(maxima.begin(), maxima.end());
+}
+
+double S21Matrix::FrobeniusNorm() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  auto sum_of_squares = [this](double scale) {
+    return SumRows(rows_, cols_, [this, scale](int i) {
+      const double* row = matrix_[i];
+      return PairwiseSum(0, cols_, [row, scale](int j) {
+        double x = row[j] * scale;
+        return x * x;
+      });
+    });
+  };
+  double sum = sum_of_squares(1);
+  const double tiny = std::numeric_limits<double>::min() /
+                      std::numeric_limits<double>::epsilon();
+  if (std::isfinite(sum) && sum >= tiny) return std::sqrt(sum);
+  // Squares overflowed or underflowed: rescale by the largest element.
+  double largest = MaxAbs();
+  if (largest == 0 || !std::isfinite(largest)) return largest;
+  return largest * std::sqrt(sum_of_squares(1 / largest));
+}
+
+S21Matrix S21Matrix::RowSums() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  std::vector<double> sums = PerRow(rows_, cols_, [this](int i) {
+    const double* row = matrix_[i];
+    return PairwiseSum(0, cols_, [row](int j) { return row[j]; });
+  });
+  S21Matrix result(rows_, 1, kS21Uninitialized);
+  for (int i = 0; i < rows_; ++i) result.matrix_[i][0] = sums[i];
+  return result;
+}
+
+S21Matrix S21Matrix::ColSums() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  std::vector<double> sums = ColumnSums(matrix_, rows_, cols_, Identity);
+  S21Matrix result(1, cols_, kS21Uninitialized);
+  std::copy(sums.begin(), sums.end(), result.matrix_[0]);
+  return result;
+}
+
+double S21Matrix::OneNorm() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  std::vector<double> sums = ColumnSums(matrix_, rows_, cols_, Absolute);
+  return *std::max_element(sums.begin(), sums.end());
+}
+
+double S21Matrix::InfNorm() const {
+  if (IsInvalid()) S21_THROW(std::invalid_argument("Invalid matrix"));
+  std::vector<double> sums = PerRow(rows_, cols_, [this](int i) {
+    const double* row = matrix_[i];
+    return PairwiseSum(0, cols_, [row](int j) { return std::fabs(row[j]); });
+  });
+  return *std::max_element(sums.begin(), sums.end());
+}
+
+double S21Matrix::TwoNormEstimate(int max_iterations,
+                                  double tolerance) const {
+  if (IsInvalid() || max_iterations < 1) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  // Power iteration on A^T A. The start vector weights each column by its
+  // absolute sum and a fixed irregular factor, so that it is not
+  // orthogonal to the dominant singular vector for sign patterns like
+  // [1 -1].
+  std::vector<double> x = ColumnSums(matrix_, rows_, cols_, Absolute);
+  for (int j = 0; j < cols_; ++j) x[j] *= 1.5 + std::sin(j + 1.0);
+  double norm = Norm2(x);
+  if (norm == 0) return 0;
+  for (double& value : x) value /= norm;
+
+  std::vector<double> y(rows_), z(cols_);
+  double estimate = 0;
+  for (int iteration = 0; iteration < max_iterations; ++iteration) {
+    s21_detail::ParallelFor(0, rows_, s21_detail::GrainFor(2L * cols_),
+                            [&](int lo, int hi) {
+                              for (int i = lo; i < hi; ++i) {
+                                const double* row = matrix_[i];
+                                y[i] = PairwiseSum(0, cols_, [&](int j) {
+                                  return row[j] * x[j];
+                                });
+                              }
+                            });
+    s21_detail::ParallelFor(0, cols_, s21_detail::GrainFor(2L * rows_),
+                            [&](int lo, int hi) {
+                              std::fill(z.begin() + lo, z.begin() + hi, 0.0);
+                              for (int i = 0; i < rows_; ++i) {
+                                const double* row = matrix_[i];
+                                double factor = y[i];
+                                for (int j = lo; j < hi; ++j) {
+                                  z[j] += factor * row[j];
+                                }
+                              }
+                            });
+    norm = Norm2(z);
+    if (norm == 0) return estimate;
+    double previous = estimate;
+    estimate = std::sqrt(norm);
+    for (int j = 0; j < cols_; ++j) x[j] = z[j] / norm;
+    if (std::fabs(estimate - previous) <= tolerance * estimate) break;
+  }
+  return estimate;
+}
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_reference.h"
+
+namespace s21_reference {
+
+namespace {
+
+Dense Minor(const Dense& a, int skip_row, int skip_col) {
+  Dense minor(a.rows - 1, a.cols - 1);
+  for (int row = 0, m_row = 0; row < a.rows; row++) {
+    if (row == skip_row) continue;
+    for (int col = 0, m_col = 0; col < a.cols; col++) {
+      if (col == skip_col) continue;
+      minor(m_row, m_col++) = a(row, col);
+    }
+    m_row++;
+  }
+  return minor;
+}
+
+void CheckSquare(const Dense& a) {
+  if (a.rows <= 0 || a.rows != a.cols) {
+    throw std::invalid_argument("Invalid matrix");
+  }
+}
+
+void CheckSame(const Dense& a, const Dense& b) {
+  if (a.rows != b.rows || a.cols != b.cols) {
+    throw std::invalid_argument("Invalid matrix");
+  }
+}
+
+}  // namespace
+
+Dense::Dense(int rows, int cols)
+    : rows(rows), cols(cols), values(1L * rows * cols, 0.0) {}
+
+Dense::Dense(const S21Matrix& matrix)
+    : Dense(matrix.GetRows(), matrix.GetCols()) {
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) (*this)(i, j) = matrix(i, j);
+  }
+}
+
+S21Matrix Dense::ToMatrix() const {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) result(i, j) = (*this)(i, j);
+  }
+  return result;
+}
+
+Dense Sum(const Dense& a, const Dense& b) {
+  CheckSame(a, b);
+  Dense result(a);
+  for (size_t i = 0; i < result.values.size(); i++) {
+    result.values[i] = a.values[i] + b.values[i];
+  }
+  return result;
+}
+
+Dense Sub(const Dense& a, const Dense& b) {
+  CheckSame(a, b);
+  Dense result(a);
+  for (size_t i = 0; i < result.values.size(); i++) {
+    result.values[i] = a.values[i] - b.values[i];
+  }
+  return result;
+}
+
+Dense MulNumber(const Dense& a, double number) {
+  Dense result(a);
+  for (double& value : result.values) value *= number;
+  return result;
+}
+
+Dense Mul(const Dense& a, const Dense& b) {
+  if (a.cols != b.rows) throw std::invalid_argument("Invalid matrix");
+  Dense result(a.rows, b.cols);
+  for (int k = 0; k < a.rows; k++) {
+    for (int i = 0; i < b.cols; i++) {
+      for (int j = 0; j < a.cols; j++) result(k, i) += a(k, j) * b(j, i);
+    }
+  }
+  return result;
+}
+
+Dense AbsMul(const Dense& a, const Dense& b) {
+  Dense abs_a(a), abs_b(b);
+  for (double& value : abs_a.values) value = std::fabs(value);
+  for (double& value : abs_b.values) value = std::fabs(value);
+  return Mul(abs_a, abs_b);
+}
+
+Dense Transpose(const Dense& a) {
+  Dense result(a.cols, a.rows);
+  for (int i = 0; i < a.rows; i++) {
+    for (int j = 0; j < a.cols; j++) result(j, i) = a(i, j);
+  }
+  return result;
+}
+
+double Determinant(const Dense& a) {
+  CheckSquare(a);
+  if (a.rows == 1) return a(0, 0);
+  if (a.rows == 2) return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+  double result = 0;
+  for (int f = 0; f < a.rows; f++) {
+    result += a(0, f) * Determinant(Minor(a, 0, f)) * (f % 2 == 0 ? 1 : -1);
+  }
+  return result;
+}
+
+Dense CalcComplements(const Dense& a) {
+  CheckSquare(a);
+  Dense result(a.rows, a.cols);
+  if (a.rows == 1) {
+    result(0, 0) = 1;
+    return result;
+  }
+  for (int i = 0; i < a.rows; i++) {
+    for (int j = 0; j < a.cols; j++) {
+      result(i, j) = ((i + j) % 2 == 0 ? 1 : -1) * Determinant(Minor(a, i, j));
+    }
+  }
+  return result;
+}
+
+Dense InverseMatrix(const Dense& a) {
+  double determinant = Determinant(a);
+  if (std::fabs(determinant) < 1e-6) {
+    throw std::invalid_argument("Invalid matrix");
+  }
+  if (a.rows == 1) {
+    Dense result(1, 1);
+    result(0, 0) = 1.0 / a(0, 0);
+    return result;
+  }
+  Dense result = CalcComplements(Transpose(a));
+  for (double& value : result.values) value *= 1 / determinant;
+  return result;
+}
+
+bool Matches(const S21Matrix& actual, const Dense& expected,
+             const Dense& scale, double factor) {
+  if (actual.GetRows() != expected.rows || actual.GetCols() != expected.cols) {
+    return false;
+  }
+  bool exact = scale.values.empty();
+  for (int i = 0; i < expected.rows; i++) {
+    for (int j = 0; j < expected.cols; j++) {
+      double x = actual(i, j), y = expected(i, j);
+      if (std::isnan(x) || std::isnan(y)) {
+        if (std::isnan(x) != std::isnan(y)) return false;
+        continue;
+      }
+      if (std::isinf(x) || std::isinf(y)) {
+        if (x != y) return false;
+        continue;
+      }
+      double allowed = exact ? 0 : factor * scale(i, j) + 1e-300;
+      if (std::fabs(x - y) > allowed) return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace s21_reference
@@ -0,0 +1,110 @@
+#include "s21_result_cache.h"
+
+namespace {
+
+std::size_t FootprintOf(const S21Matrix& matrix) {
+  return sizeof(double) * std::size_t(matrix.GetRows()) * matrix.GetCols();
+}
+
+}  // namespace
+
+S21ResultCache::S21ResultCache(std::size_t budget_bytes)
+    : budget_(budget_bytes), stats_{0, 0, 0, 0, 0} {}
+
+template <class Compute>
+S21Matrix S21ResultCache::Lookup(Operation operation, const S21Matrix& matrix,
+                                 Compute compute) {
+  Key key{operation, matrix.Fingerprint()};
+  std::shared_ptr<const Entry> candidate;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end()) candidate = *found->second;
+  }
+  if (candidate && candidate->input.ExactEqual(matrix)) {
+    S21Matrix result = candidate->result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = index_.find(key);
+    if (found != index_.end() && *found->second == candidate) {
+      lru_.splice(lru_.begin(), lru_, found->second);
+    }
+    ++stats_.hits;
+    return result;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.misses;
+  }
+
+  S21Matrix result = compute();
+  std::size_t bytes = sizeof(Entry) + FootprintOf(matrix) + FootprintOf(result);
+  if (bytes > GetBudget()) return result;
+  auto entry =
+      std::make_shared<const Entry>(Entry{key, matrix, result, bytes});
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    stats_.bytes -= (*found->second)->bytes;
+    lru_.erase(found->second);
+    index_.erase(found);
+  }
+  lru_.push_front(std::move(entry));
+  index_[key] = lru_.begin();
+  stats_.bytes += bytes;
+  EvictLocked();
+  return result;
+}
+
+void S21ResultCache::EvictLocked() {
+  while (stats_.bytes > budget_ && !lru_.empty()) {
+    const Entry& victim = *lru_.back();
+    stats_.bytes -= victim.bytes;
+    index_.erase(victim.key);
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+  stats_.entries = lru_.size();
+}
+
+S21Matrix S21ResultCache::InverseMatrix(const S21Matrix& matrix) {
+  return Lookup(Operation::kInverse, matrix,
+                [&matrix] { return matrix.InverseMatrix(); });
+}
+
+S21Matrix S21ResultCache::CalcComplements(const S21Matrix& matrix) {
+  return Lookup(Operation::kComplements, matrix,
+                [&matrix] { return matrix.CalcComplements(); });
+}
+
+double S21ResultCache::Determinant(const S21Matrix& matrix) {
+  S21Matrix result = Lookup(Operation::kDeterminant, matrix, [&matrix] {
+    S21Matrix value;
+    value(0, 0) = matrix.Determinant();
+    return value;
+  });
+  return result(0, 0);
+}
+
+S21ResultCache::Stats S21ResultCache::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void S21ResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  index_.clear();
+  stats_.bytes = 0;
+  stats_.entries = 0;
+}
+
+void S21ResultCache::SetBudget(std::size_t budget_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  budget_ = budget_bytes;
+  EvictLocked();
+}
+
+std::size_t S21ResultCache::GetBudget() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return budget_;
+}
@@ -0,0 +1,316 @@
+#include <algorithm>
+
+#include "s21_kernels.h"
+#include "s21_parallel.h"
+#include "s21_structured.h"
+
+S21StructuredMatrix::S21StructuredMatrix(S21Structure structure, int size,
+                                         int lower, int upper)
+    : structure_(structure), size_(size), lower_(0), upper_(0) {
+  if (size <= 0 || structure == S21Structure::kGeneral) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  long count = size;
+  switch (structure) {
+    case S21Structure::kUpperTriangular:
+      upper_ = size - 1;
+      count = 1L * size * (size + 1) / 2;
+      break;
+    case S21Structure::kLowerTriangular:
+      lower_ = size - 1;
+      count = 1L * size * (size + 1) / 2;
+      break;
+    case S21Structure::kSymmetric:
+      lower_ = upper_ = size - 1;
+      count = 1L * size * (size + 1) / 2;
+      break;
+    case S21Structure::kBanded:
+      if (lower < 0 || upper < 0 || lower >= size || upper >= size) {
+        S21_THROW(std::invalid_argument("Invalid matrix"));
+      }
+      lower_ = lower;
+      upper_ = upper;
+      count = 1L * size * (lower + upper + 1);
+      break;
+    default:
+      break;
+  }
+  data_.assign(count, 0.0);
+}
+
+S21StructuredMatrix::S21StructuredMatrix(const S21Matrix& dense,
+                                         S21Structure structure, int lower,
+                                         int upper)
+    : S21StructuredMatrix(structure, dense.GetRows(), lower, upper) {
+  if (dense.IsInvalid() || dense.rows_ != dense.cols_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  for (int i = 0; i < size_; ++i) {
+    for (int j = 0; j < size_; ++j) {
+      double value = dense.matrix_[i][j];
+      long index = Index(i, j);
+      if (index < 0) {
+        if (value != 0) S21_THROW(std::invalid_argument("Invalid matrix"));
+      } else if (structure_ == S21Structure::kSymmetric && j > i) {
+        if (std::fabs(value - dense.matrix_[j][i]) >= 1e-07) {
+          S21_THROW(std::invalid_argument("Invalid matrix"));
+        }
+      } else {
+        data_[index] = value;
+      }
+    }
+  }
+}
+
+// Position of (row, col) in data_, -1 when the structure forces a zero.
+// Packed storage outgrows int from n of about 65536, so offsets are long.
+long S21StructuredMatrix::Index(int row, int col) const {
+  long r = row, c = col;
+  switch (structure_) {
+    case S21Structure::kDiagonal:
+      return row == col ? r : -1;
+    case S21Structure::kUpperTriangular:
+      return col < row ? -1 : r * size_ - r * (r - 1) / 2 + c - r;
+    case S21Structure::kLowerTriangular:
+      return col > row ? -1 : r * (r + 1) / 2 + c;
+    case S21Structure::kSymmetric:
+      return row >= col ? r * (r + 1) / 2 + c : c * (c + 1) / 2 + r;
+    case S21Structure::kBanded:
+      if (col - row > upper_ || row - col > lower_) return -1;
+      return r * (lower_ + upper_ + 1) + c - r + lower_;
+    default:
+      return -1;
+  }
+}
+
+int S21StructuredMatrix::RowBegin(int row) const {
+  return std::max(0, row - lower_);
+}
+
+int S21StructuredMatrix::RowEnd(int row) const {
+  return std::min(size_, row + upper_ + 1);
+}
+
+double& S21StructuredMatrix::operator()(int row, int col) {
+  long index = -1;
+  if (row >= 0 && row < size_ && col >= 0 && col < size_) {
+    index = Index(row, col);
+  }
+  if (index < 0) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  return data_[index];
+}
+
+double S21StructuredMatrix::operator()(int row, int col) const {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  long index = Index(row, col);
+  return index < 0 ? 0 : data_[index];
+}
+
+S21Structure S21StructuredMatrix::GetStructure() const { return structure_; }
+int S21StructuredMatrix::GetSize() const { return size_; }
+int S21StructuredMatrix::GetLower() const { return lower_; }
+int S21StructuredMatrix::GetUpper() const { return upper_; }
+
+S21Matrix S21StructuredMatrix::ToDense() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; ++i) {
+    for (int j = RowBegin(i); j < RowEnd(i); ++j) {
+      result.matrix_[i][j] = data_[Index(i, j)];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21StructuredMatrix::MulMatrix(const S21Matrix& other) const {
+  if (other.IsInvalid() || other.rows_ != size_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int cols = other.cols_;
+  S21Matrix result(size_, cols);
+  long row_work = 2L * cols * (RowEnd(size_ / 2) - RowBegin(size_ / 2));
+  s21_detail::ParallelFor(0, size_, s21_detail::GrainFor(row_work),
+                          [&](int lo, int hi) {
+                            for (int i = lo; i < hi; ++i) {
+                              double* out = result.matrix_[i];
+                              for (int j = RowBegin(i); j < RowEnd(i); ++j) {
+                                double value = data_[Index(i, j)];
+                                const double* in = other.matrix_[j];
+                                for (int c = 0; c < cols; ++c) {
+                                  out[c] += value * in[c];
+                                }
+                              }
+                            }
+                          });
+  return result;
+}
+
+// LU with partial pivoting in LAPACK band layout: entry (i, j) lives at
+// ab[j * ldab + kv + i - j] with kv = lower + upper, leaving room for the
+// `lower` extra superdiagonals that pivoting fills in.
+double S21StructuredMatrix::BandFactor(std::vector<double>& ab,
+                                       std::vector<int>& pivots) const {
+  int n = size_, kl = lower_, kv = lower_ + upper_, ldab = 2 * kl + upper_ + 1;
+  auto at = [&ab, kv, ldab](int i, int j) -> double& {
+    return ab[1L * j * ldab + kv + i - j];
+  };
+  ab.assign(1L * n * ldab, 0.0);
+  pivots.assign(n, 0);
+  for (int i = 0; i < n; ++i) {
+    for (int j = RowBegin(i); j < RowEnd(i); ++j) at(i, j) = data_[Index(i, j)];
+  }
+  double determinant = 1;
+  for (int k = 0; k < n; ++k) {
+    int last = std::min(n - 1, k + kl);
+    int last_col = std::min(n - 1, k + kv);
+    int pivot = k;
+    for (int i = k + 1; i <= last; ++i) {
+      if (std::fabs(at(i, k)) > std::fabs(at(pivot, k))) pivot = i;
+    }
+    pivots[k] = pivot;
+    if (at(pivot, k) == 0) return 0;
+    if (pivot != k) {
+      for (int j = k; j <= last_col; ++j) std::swap(at(k, j), at(pivot, j));
+      determinant = -determinant;
+    }
+    determinant *= at(k, k);
+    for (int i = k + 1; i <= last; ++i) {
+      double factor = at(i, k) / at(k, k);
+      at(i, k) = factor;
+      if (factor == 0) continue;
+      for (int j = k + 1; j <= last_col; ++j) at(i, j) -= factor * at(k, j);
+    }
+  }
+  return determinant;
+}
+
+// Overwrites the n x cols right-hand side b with the solution, from the
+// factors BandFactor left in ab and pivots.
+void S21StructuredMatrix::BandSolve(const std::vector<double>& ab,
+                                    const std::vector<int>& pivots,
+                                    double** b, int cols) const {
+  int n = size_, kv = lower_ + upper_, ldab = 2 * lower_ + upper_ + 1;
+  auto at = [&ab, kv, ldab](int i, int j) {
+    return ab[1L * j * ldab + kv + i - j];
+  };
+  for (int k = 0; k < n; ++k) {
+    if (pivots[k] != k) std::swap_ranges(b[k], b[k] + cols, b[pivots[k]]);
+    int last = std::min(n - 1, k + lower_);
+    for (int i = k + 1; i <= last; ++i) {
+      double factor = at(i, k);
+      for (int c = 0; c < cols; ++c) b[i][c] -= factor * b[k][c];
+    }
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    int last_col = std::min(n - 1, i + kv);
+    for (int j = i + 1; j <= last_col; ++j) {
+      double factor = at(i, j);
+      for (int c = 0; c < cols; ++c) b[i][c] -= factor * b[j][c];
+    }
+    double divisor = at(i, i);
+    for (int c = 0; c < cols; ++c) b[i][c] /= divisor;
+  }
+}
+
+S21Matrix S21StructuredMatrix::Solve(const S21Matrix& other) const {
+  if (other.IsInvalid() || other.rows_ != size_) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int n = size_, cols = other.cols_;
+  S21Matrix x(other);
+  x.touch();
+  double** b = x.matrix_;
+  auto axpy = [cols](double* y, double alpha, const double* v) {
+    for (int c = 0; c < cols; ++c) y[c] -= alpha * v[c];
+  };
+  auto scale = [cols](double* y, double divisor) {
+    if (divisor == 0) S21_THROW(std::invalid_argument("Invalid matrix"));
+    for (int c = 0; c < cols; ++c) y[c] /= divisor;
+  };
+
+  if (structure_ == S21Structure::kDiagonal) {
+    for (int i = 0; i < n; ++i) scale(b[i], data_[i]);
+  } else if (structure_ == S21Structure::kLowerTriangular) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < i; ++j) axpy(b[i], data_[Index(i, j)], b[j]);
+      scale(b[i], data_[Index(i, i)]);
+    }
+  } else if (structure_ == S21Structure::kUpperTriangular) {
+    for (int i = n - 1; i >= 0; --i) {
+      for (int j = i + 1; j < n; ++j) axpy(b[i], data_[Index(i, j)], b[j]);
+      scale(b[i], data_[Index(i, i)]);
+    }
+  } else if (structure_ == S21Structure::kBanded) {
+    std::vector<double> ab;
+    std::vector<int> pivots;
+    if (BandFactor(ab, pivots) == 0) {
+      S21_THROW(std::invalid_argument("Invalid matrix"));
+    }
+    BandSolve(ab, pivots, b, cols);
+  } else {
+    S21Matrix lu = ToDense();
+    std::vector<int> pivots(n);
+    if (s21_detail::LuFactor(lu.matrix_, n, pivots.data()) == 0) {
+      S21_THROW(std::invalid_argument("Invalid matrix"));
+    }
+    s21_detail::LuSolve(lu.matrix_, n, pivots.data(), b, cols);
+  }
+  return x;
+}
+
+double S21StructuredMatrix::Determinant() const {
+  if (structure_ == S21Structure::kBanded) {
+    std::vector<double> ab;
+    std::vector<int> pivots;
+    return BandFactor(ab, pivots);
+  }
+  if (structure_ == S21Structure::kSymmetric) {
+    S21Matrix lu = ToDense();
+    std::vector<int> pivots(size_);
+    return s21_detail::LuFactor(lu.matrix_, size_, pivots.data());
+  }
+  double result = 1;
+  for (int i = 0; i < size_; ++i) result *= data_[Index(i, i)];
+  return result;
+}
+
+double S21StructuredMatrix::Invert(S21Matrix* inverse) const {
+  int n = size_;
+  double determinant = 0;
+  if (structure_ == S21Structure::kBanded) {
+    std::vector<double> ab;
+    std::vector<int> pivots;
+    determinant = BandFactor(ab, pivots);
+    if (!(std::fabs(determinant) >= 1e-6)) return determinant;
+    S21Matrix result(n, n);
+    for (int i = 0; i < n; ++i) result.matrix_[i][i] = 1;
+    BandSolve(ab, pivots, result.matrix_, n);
+    *inverse = std::move(result);
+  } else if (structure_ == S21Structure::kSymmetric) {
+    S21Matrix lu = ToDense();
+    std::vector<int> pivots(n);
+    determinant = s21_detail::LuFactor(lu.matrix_, n, pivots.data());
+    if (!(std::fabs(determinant) >= 1e-6)) return determinant;
+    S21Matrix result(n, n, kS21Uninitialized);
+    s21_detail::LuInverse(lu.matrix_, n, pivots.data(), result.matrix_);
+    *inverse = std::move(result);
+  } else {
+    determinant = Determinant();
+    if (!(std::fabs(determinant) >= 1e-6)) return determinant;
+    S21Matrix identity(n, n);
+    for (int i = 0; i < n; ++i) identity.matrix_[i][i] = 1;
+    *inverse = Solve(identity);
+  }
+  return determinant;
+}
+
+S21Matrix S21StructuredMatrix::InverseMatrix() const {
+  S21Matrix result;
+  if (!(std::fabs(Invert(&result)) >= 1e-6)) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  return result;
+}
@@ -0,0 +1,296 @@
+#include "s21_task_graph.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace {
+
+enum class NodeState {
+  kWaiting,
+  kQueued,
+  kRunning,
+  kDone,
+  kFailed,
+  kCancelled
+};
+
+}  // namespace
+
+struct S21TaskGraph::Core {
+  S21ThreadPool* pool;
+  std::mutex mutex;
+  std::condition_variable changed;
+};
+
+struct S21TaskGraph::Node {
+  std::shared_ptr<Core> core;
+  std::function<void(Node&)> work;
+  std::vector<std::shared_ptr<Node>> inputs;
+  std::vector<std::shared_ptr<Node>> dependents;
+  int waiting = 0;
+  int priority = 0;
+  NodeState state = NodeState::kWaiting;
+  bool finished = false;
+  S21Matrix result;
+  double scalar = 0;
+  std::exception_ptr error;
+};
+
+// HANDLE
+
+S21TaskGraph::Handle::Handle(std::shared_ptr<Node> node)
+    : node_(std::move(node)) {}
+
+void S21TaskGraph::Handle::Wait() const {
+  if (!node_) {
+    throw std::invalid_argument("Invalid argument");
+  }
+  std::unique_lock<std::mutex> lock(node_->core->mutex);
+  node_->core->changed.wait(lock, [this] { return node_->finished; });
+}
+
+bool S21TaskGraph::Handle::IsReady() const {
+  if (!node_) return false;
+  std::lock_guard<std::mutex> lock(node_->core->mutex);
+  return node_->finished;
+}
+
+const S21Matrix& S21TaskGraph::Handle::Get() const {
+  Wait();
+  if (node_->state == NodeState::kFailed) {
+    std::rethrow_exception(node_->error);
+  }
+  if (node_->state == NodeState::kCancelled) {
+    throw std::runtime_error("Task cancelled");
+  }
+  return node_->result;
+}
+
+double S21TaskGraph::Handle::GetScalar() const {
+  Get();
+  return node_->scalar;
+}
+
+bool S21TaskGraph::Handle::Cancel() const {
+  if (!node_) return false;
+  std::lock_guard<std::mutex> lock(node_->core->mutex);
+  if (node_->state != NodeState::kWaiting &&
+      node_->state != NodeState::kQueued) {
+    return false;
+  }
+  // A queued node stays in the pool queue; Run skips it.
+  node_->state = NodeState::kCancelled;
+  Finish(node_);
+  node_->core->changed.notify_all();
+  return true;
+}
+
+// GRAPH
+
+S21TaskGraph::S21TaskGraph(S21ThreadPool& pool)
+    : core_(std::make_shared<Core>()) {
+  core_->pool = &pool;
+}
+
+S21TaskGraph::~S21TaskGraph() { WaitAll(); }
+
+// A node that is not finished yet is held by the pool queue or by its
+// inputs, so an expired entry is always a finished node.
+void S21TaskGraph::WaitAll() const {
+  for (const auto& weak : nodes_) {
+    if (auto node = weak.lock()) Handle(node).Wait();
+  }
+}
+
+void S21TaskGraph::CancelAll() {
+  for (const auto& weak : nodes_) {
+    if (auto node = weak.lock()) Handle(node).Cancel();
+  }
+}
+
+// Expired entries are dropped whenever the list would grow, which keeps
+// it proportional to the live nodes of a long-running graph.
+void S21TaskGraph::Track(const std::shared_ptr<Node>& node) {
+  if (nodes_.size() == nodes_.capacity()) {
+    nodes_.erase(std::remove_if(nodes_.begin(), nodes_.end(),
+                                [](const std::weak_ptr<Node>& weak) {
+                                  return weak.expired();
+                                }),
+                 nodes_.end());
+  }
+  nodes_.push_back(node);
+}
+
+S21TaskGraph::Handle S21TaskGraph::AddNode(const std::vector<Handle>& inputs,
+                                           std::function<void(Node&)> work,
+                                           int priority) {
+  auto node = std::make_shared<Node>();
+  node->core = core_;
+  node->work = std::move(work);
+  node->priority = priority;
+  std::lock_guard<std::mutex> lock(core_->mutex);
+  for (const Handle& input : inputs) {
+    if (!input.node_ || input.node_->core != core_) {
+      throw std::invalid_argument("Invalid argument");
+    }
+  }
+  for (const Handle& input : inputs) {
+    const std::shared_ptr<Node>& parent = input.node_;
+    node->inputs.push_back(parent);
+    if (parent->finished && parent->state != NodeState::kDone) {
+      node->state = parent->state;
+      node->error = parent->error;
+    } else if (!parent->finished) {
+      parent->dependents.push_back(node);
+      ++node->waiting;
+    }
+  }
+  if (node->state != NodeState::kWaiting) {
+    Finish(node);
+  } else if (node->waiting == 0) {
+    node->state = NodeState::kQueued;
+    Schedule(node);
+  }
+  Track(node);
+  return Handle(node);
+}
+
+void S21TaskGraph::Schedule(const std::shared_ptr<Node>& node) {
+  node->core->pool->Submit([node] { Run(node); }, node->priority);
+}
+
+void S21TaskGraph::Run(const std::shared_ptr<Node>& node) {
+  {
+    std::lock_guard<std::mutex> lock(node->core->mutex);
+    if (node->state != NodeState::kQueued) return;
+    node->state = NodeState::kRunning;
+  }
+  NodeState outcome = NodeState::kDone;
+  std::exception_ptr error;
+  try {
+    node->work(*node);
+  } catch (...) {
+    outcome = NodeState::kFailed;
+    error = std::current_exception();
+  }
+  std::lock_guard<std::mutex> lock(node->core->mutex);
+  node->state = outcome;
+  node->error = error;
+  Finish(node);
+  node->core->changed.notify_all();
+}
+
+// Marks a node with a terminal state as finished and releases its
+// dependents: queued once their last input is done, or finished with the
+// same failure right away. Called with the core mutex held.
+void S21TaskGraph::Finish(const std::shared_ptr<Node>& node) {
+  std::vector<std::shared_ptr<Node>> pending{node};
+  while (!pending.empty()) {
+    std::shared_ptr<Node> current = std::move(pending.back());
+    pending.pop_back();
+    current->finished = true;
+    current->inputs.clear();
+    std::vector<std::shared_ptr<Node>> dependents;
+    dependents.swap(current->dependents);
+    for (auto& dependent : dependents) {
+      if (dependent->finished) continue;
+      if (current->state != NodeState::kDone) {
+        dependent->state = current->state;
+        dependent->error = current->error;
+        pending.push_back(dependent);
+      } else if (--dependent->waiting == 0) {
+        dependent->state = NodeState::kQueued;
+        Schedule(dependent);
+      }
+    }
+  }
+}
+
+// OPERATIONS
+
+S21TaskGraph::Handle S21TaskGraph::Input(S21Matrix matrix) {
+  auto node = std::make_shared<Node>();
+  node->core = core_;
+  node->result = std::move(matrix);
+  node->state = NodeState::kDone;
+  node->finished = true;
+  Track(node);
+  return Handle(node);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Sum(const Handle& a, const Handle& b,
+                                       int priority) {
+  return AddNode(
+      {a, b},
+      [](Node& n) { n.result = n.inputs[0]->result + n.inputs[1]->result; },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Sub(const Handle& a, const Handle& b,
+                                       int priority) {
+  return AddNode(
+      {a, b},
+      [](Node& n) { n.result = n.inputs[0]->result - n.inputs[1]->result; },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Mul(const Handle& a, const Handle& b,
+                                       int priority) {
+  return AddNode(
+      {a, b},
+      [](Node& n) { n.result = n.inputs[0]->result * n.inputs[1]->result; },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::MulNumber(const Handle& a, double num,
+                                             int priority) {
+  return AddNode(
+      {a}, [num](Node& n) { n.result = n.inputs[0]->result * num; },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Transpose(const Handle& a, int priority) {
+  return AddNode(
+      {a}, [](Node& n) { n.result = n.inputs[0]->result.Transpose(); },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Inverse(const Handle& a, int priority) {
+  return AddNode(
+      {a}, [](Node& n) { n.result = n.inputs[0]->result.InverseMatrix(); },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Complements(const Handle& a,
+                                               int priority) {
+  return AddNode(
+      {a}, [](Node& n) { n.result = n.inputs[0]->result.CalcComplements(); },
+      priority);
+}
+
+// The determinant is also stored as a 1 x 1 result so it can feed Apply.
+S21TaskGraph::Handle S21TaskGraph::Determinant(const Handle& a,
+                                               int priority) {
+  return AddNode(
+      {a},
+      [](Node& n) {
+        n.scalar = n.inputs[0]->result.Determinant();
+        n.result(0, 0) = n.scalar;
+      },
+      priority);
+}
+
+S21TaskGraph::Handle S21TaskGraph::Apply(const std::vector<Handle>& inputs,
+                                         Operation operation, int priority) {
+  return AddNode(
+      inputs,
+      [operation](Node& n) {
+        std::vector<const S21Matrix*> matrices;
+        matrices.reserve(n.inputs.size());
+        for (const auto& input : n.inputs) matrices.push_back(&input->result);
+        n.result = operation(matrices);
+      },
+      priority);
+}
@@ -0,0 +1,55 @@
+#include "s21_thread_pool.h"
+
+#include "s21_parallel.h"
+
+S21ThreadPool::S21ThreadPool(int threads)
+    : next_sequence_(0), stopping_(false) {
+  if (threads <= 0) threads = s21_detail::WorkerCount();
+  workers_.reserve(threads);
+  for (int i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i] {
+      s21_detail::PinWorker(i);
+      WorkerLoop();
+    });
+  }
+}
+
+S21ThreadPool::~S21ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+void S21ThreadPool::Submit(std::function<void()> task, int priority) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(Task{priority, next_sequence_++, std::move(task)});
+  }
+  ready_.notify_one();
+}
+
+int S21ThreadPool::GetThreadCount() const {
+  return static_cast<int>(workers_.size());
+}
+
+S21ThreadPool& S21ThreadPool::Shared() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+void S21ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> run;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      run = std::move(const_cast<Task&>(queue_.top()).run);
+      queue_.pop();
+    }
+    run();
+  }
+}
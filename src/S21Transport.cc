@@ -0,0 +1,194 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "s21_transport.h"
+
+namespace {
+
+std::string SocketPath(const std::string& directory, int rank) {
+  return directory + "/s21-" + std::to_string(rank) + ".sock";
+}
+
+sockaddr_un Address(const std::string& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("Invalid argument");
+  }
+  std::strcpy(address.sun_path, path.c_str());
+  return address;
+}
+
+void WriteAll(int socket, const void* data, std::size_t bytes) {
+  const char* bytes_left = static_cast<const char*>(data);
+  while (bytes > 0) {
+    ssize_t written = send(socket, bytes_left, bytes, MSG_NOSIGNAL);
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) throw std::runtime_error("S21Transport: send failed");
+    bytes_left += written;
+    bytes -= written;
+  }
+}
+
+void ReadAll(int socket, void* data, std::size_t bytes) {
+  char* bytes_left = static_cast<char*>(data);
+  while (bytes > 0) {
+    ssize_t received = recv(socket, bytes_left, bytes, 0);
+    if (received < 0 && errno == EINTR) continue;
+    if (received <= 0) {
+      throw std::runtime_error("S21Transport: peer closed the connection");
+    }
+    bytes_left += received;
+    bytes -= received;
+  }
+}
+
+}  // namespace
+
+S21SocketTransport::S21SocketTransport(int rank, std::vector<int> sockets)
+    : rank_(rank), sockets_(std::move(sockets)) {}
+
+S21SocketTransport::S21SocketTransport(int rank, int size,
+                                       const std::string& directory)
+    : rank_(rank), sockets_(size, -1) {
+  if (size <= 0 || rank < 0 || rank >= size) {
+    throw std::invalid_argument("Invalid argument");
+  }
+  std::string path = SocketPath(directory, rank);
+  sockaddr_un address = Address(path);
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(path.c_str());
+  if (listener < 0 ||
+      bind(listener, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) != 0 ||
+      listen(listener, size) != 0) {
+    if (listener >= 0) close(listener);
+    throw std::runtime_error("S21Transport: cannot listen on " + path);
+  }
+  // Lower ranks may not be listening yet: retry for a while.
+  for (int peer = 0; peer < rank; ++peer) {
+    sockaddr_un peer_address = Address(SocketPath(directory, peer));
+    for (int attempt = 0; sockets_[peer] < 0; ++attempt) {
+      int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (connect(connection, reinterpret_cast<sockaddr*>(&peer_address),
+                  sizeof(peer_address)) == 0) {
+        sockets_[peer] = connection;
+        WriteAll(connection, &rank_, sizeof(rank_));
+        break;
+      }
+      close(connection);
+      if (attempt == 1000) {
+        close(listener);
+        throw std::runtime_error("S21Transport: no peer " +
+                                 std::to_string(peer));
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  for (int accepted = rank + 1; accepted < size; ++accepted) {
+    int connection = accept(listener, nullptr, nullptr);
+    int peer = -1;
+    if (connection >= 0) ReadAll(connection, &peer, sizeof(peer));
+    if (peer <= rank || peer >= size || sockets_[peer] >= 0) {
+      close(listener);
+      throw std::runtime_error("S21Transport: unexpected connection");
+    }
+    sockets_[peer] = connection;
+  }
+  close(listener);
+  unlink(path.c_str());
+}
+
+S21SocketTransport::~S21SocketTransport() {
+  for (int socket : sockets_) {
+    if (socket >= 0) close(socket);
+  }
+}
+
+int S21SocketTransport::GetRank() const { return rank_; }
+
+int S21SocketTransport::GetSize() const {
+  return static_cast<int>(sockets_.size());
+}
+
+void S21SocketTransport::Send(int peer, const void* data, std::size_t bytes) {
+  if (peer < 0 || peer >= GetSize() || peer == rank_) {
+    throw std::invalid_argument("Invalid argument");
+  }
+  WriteAll(sockets_[peer], data, bytes);
+}
+
+void S21SocketTransport::Receive(int peer, void* data, std::size_t bytes) {
+  if (peer < 0 || peer >= GetSize() || peer == rank_) {
+    throw std::invalid_argument("Invalid argument");
+  }
+  ReadAll(sockets_[peer], data, bytes);
+}
+
+bool S21SocketTransport::RunForked(
+    int size, const std::function<void(S21Transport&)>& body) {
+  if (size <= 0) throw std::invalid_argument("Invalid argument");
+  // pairs[i][j] is the end of the i-j socket pair that rank i keeps.
+  std::vector<std::vector<int>> pairs(size, std::vector<int>(size, -1));
+  for (int i = 0; i < size; ++i) {
+    for (int j = i + 1; j < size; ++j) {
+      int ends[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends) != 0) {
+        throw std::runtime_error("S21Transport: socketpair failed");
+      }
+      pairs[i][j] = ends[0];
+      pairs[j][i] = ends[1];
+    }
+  }
+  auto keep_only = [&pairs, size](int rank) {
+    for (int i = 0; i < size; ++i) {
+      for (int j = 0; j < size; ++j) {
+        if (i != rank && pairs[i][j] >= 0) close(pairs[i][j]);
+      }
+    }
+  };
+  std::vector<pid_t> children;
+  for (int rank = 1; rank < size; ++rank) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      keep_only(rank);
+      int status = 0;
+      try {
+        S21SocketTransport transport(rank, pairs[rank]);
+        body(transport);
+      } catch (...) {
+        status = 1;
+      }
+      _exit(status);
+    }
+    if (pid < 0) {
+      for (pid_t child : children) waitpid(child, nullptr, 0);
+      throw std::runtime_error("S21Transport: fork failed");
+    }
+    children.push_back(pid);
+  }
+  keep_only(0);
+  bool ok = true;
+  try {
+    S21SocketTransport transport(0, pairs[0]);
+    body(transport);
+  } catch (...) {
+    ok = false;
+  }
+  // The transport is closed here, so children blocked on rank 0 fail
+  // instead of waiting forever.
+  for (pid_t child : children) {
+    int status = 0;
+    waitpid(child, &status, 0);
+    ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  }
+  return ok;
+}
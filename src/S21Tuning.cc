@@ -0,0 +1,250 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+#include "s21_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_small.h"
+#include "s21_tuning.h"
+
+namespace {
+
+constexpr S21TuningParameters kDefaults{};
+
+std::atomic<long> parallel_work{kDefaults.parallel_work};
+std::atomic<int> gemm_rows{kDefaults.gemm_rows};
+std::atomic<int> gemm_cols{kDefaults.gemm_cols};
+std::atomic<int> cholesky_block{kDefaults.cholesky_block};
+std::atomic<int> small_max{kDefaults.small_max};
+
+bool Valid(const S21TuningParameters& parameters) {
+  return parameters.parallel_work >= 1 && parameters.gemm_rows >= 1 &&
+         parameters.gemm_rows <= 64 && parameters.gemm_cols >= 8 &&
+         parameters.cholesky_block >= 1 && parameters.small_max >= 0 &&
+         parameters.small_max <= s21_detail::kSmallMax;
+}
+
+// Fastest of three runs, in seconds.
+double BestOf(const std::function<void()>& workload) {
+  double best = 1e300;
+  for (int run = 0; run < 3; ++run) {
+    auto start = std::chrono::steady_clock::now();
+    workload();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+// Tries every candidate for one field, the others fixed at *best.
+template <class T>
+void Choose(S21TuningParameters* best, T S21TuningParameters::*field,
+            const std::vector<T>& candidates,
+            const std::function<void()>& workload) {
+  S21Tuning::Set(*best);
+  double best_time = BestOf(workload);
+  for (T candidate : candidates) {
+    if (candidate == (*best).*field) continue;
+    S21TuningParameters trial = *best;
+    trial.*field = candidate;
+    S21Tuning::Set(trial);
+    double time = BestOf(workload);
+    if (time < 0.97 * best_time) {
+      best_time = time;
+      *best = trial;
+    }
+  }
+  S21Tuning::Set(*best);
+}
+
+// Row-major n x n storage with the row pointer table the kernels take.
+struct Buffer {
+  explicit Buffer(int n) : values(1L * n * n), rows(n) {
+    for (int i = 0; i < n; ++i) rows[i] = &values[1L * i * n];
+  }
+  std::vector<double> values;
+  std::vector<double*> rows;
+};
+
+[[maybe_unused]] const bool kLoadedAtStartup =
+    S21Tuning::Load(S21Tuning::DefaultPath());
+
+}  // namespace
+
+S21TuningParameters S21Tuning::Get() {
+  S21TuningParameters parameters;
+  parameters.parallel_work = parallel_work;
+  parameters.gemm_rows = gemm_rows;
+  parameters.gemm_cols = gemm_cols;
+  parameters.cholesky_block = cholesky_block;
+  parameters.small_max = small_max;
+  return parameters;
+}
+
+void S21Tuning::Set(const S21TuningParameters& parameters) {
+  if (!Valid(parameters)) S21_THROW(std::invalid_argument("Invalid argument"));
+  parallel_work = parameters.parallel_work;
+  gemm_rows = parameters.gemm_rows;
+  gemm_cols = parameters.gemm_cols;
+  cholesky_block = parameters.cholesky_block;
+  small_max = parameters.small_max;
+}
+
+void S21Tuning::Reset() { Set(kDefaults); }
+
+bool S21Tuning::Load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) return false;
+  S21TuningParameters parameters = Get();
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::size_t equals = line.find('=');
+    if (equals == std::string::npos) continue;
+    std::string name = line.substr(0, equals);
+    name.erase(std::remove_if(name.begin(), name.end(),
+                              [](unsigned char c) { return std::isspace(c); }),
+               name.end());
+    const char* text = line.c_str() + equals + 1;
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text || value < 0 || value > (1L << 30)) return false;
+    while (std::isspace(static_cast<unsigned char>(*end))) ++end;
+    if (*end != '\0') return false;
+    int narrow = static_cast<int>(value);
+    if (name == "parallel_work") {
+      parameters.parallel_work = value;
+    } else if (name == "gemm_rows") {
+      parameters.gemm_rows = narrow;
+    } else if (name == "gemm_cols") {
+      parameters.gemm_cols = narrow;
+    } else if (name == "cholesky_block") {
+      parameters.cholesky_block = narrow;
+    } else if (name == "small_max") {
+      parameters.small_max = narrow;
+    }
+  }
+  if (!Valid(parameters)) return false;
+  Set(parameters);
+  return true;
+}
+
+bool S21Tuning::Save(const std::string& path) {
+  S21TuningParameters parameters = Get();
+  std::ofstream file(path);
+  file << "# S21Matrix kernel parameters, see S21Tuning\n"
+       << "parallel_work = " << parameters.parallel_work << '\n'
+       << "gemm_rows = " << parameters.gemm_rows << '\n'
+       << "gemm_cols = " << parameters.gemm_cols << '\n'
+       << "cholesky_block = " << parameters.cholesky_block << '\n'
+       << "small_max = " << parameters.small_max << '\n';
+  file.close();
+  return static_cast<bool>(file);
+}
+
+std::string S21Tuning::DefaultPath() {
+  const char* path = std::getenv("S21_TUNING_FILE");
+  if (path != nullptr && *path != '\0') return path;
+  const char* home = std::getenv("HOME");
+  return std::string(home != nullptr ? home : ".") + "/.s21_matrix_tuning";
+}
+
+S21TuningParameters S21Tuning::Tune(int n) {
+  if (n < 16) S21_THROW(std::invalid_argument("Invalid argument"));
+  S21Accumulation accumulation = S21Matrix::GetAccumulation();
+  S21Matrix::SetAccumulation(S21Accumulation::kFast);
+  S21TuningParameters best = Get();
+
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = std::sin(i + 0.5 * j);
+      b(i, j) = std::cos(i - 0.25 * j);
+    }
+  }
+  auto gemm = [&] { S21Matrix::Gemm(false, false, 1, a, b, 0, &c); };
+  // Blocks at least n wide all run as one block of width n: that width is
+  // measured once, and not at all when the current setting already is one.
+  std::vector<int> widths;
+  for (int width : {128, 256, 512, 1024}) {
+    width = std::min(width, n);
+    if (width != std::min(best.gemm_cols, n) &&
+        std::find(widths.begin(), widths.end(), width) == widths.end()) {
+      widths.push_back(width);
+    }
+  }
+  Choose(&best, &S21TuningParameters::gemm_cols, widths, gemm);
+  Choose(&best, &S21TuningParameters::gemm_rows, {2, 4, 8}, gemm);
+
+  // Diagonally dominant, hence positive definite.
+  Buffer spd(n), factor(n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      spd.rows[i][j] = 1.0 / (1 + std::abs(i - j)) + (i == j ? n : 0);
+    }
+  }
+  Choose(&best, &S21TuningParameters::cholesky_block, {32, 64, 128}, [&] {
+    factor.values = spd.values;
+    double determinant;
+    s21_detail::CholeskyFactor(factor.rows.data(), n, &determinant);
+  });
+
+  // Mid-sized problems, where splitting over threads may or may not pay.
+  int half = n / 2;
+  Buffer lu(half);
+  std::vector<int> pivots(half);
+  Choose(&best, &S21TuningParameters::parallel_work,
+         {1L << 12, 1L << 14, 1L << 16, 1L << 18, 1L << 20}, [&] {
+           for (int i = 0; i < half; ++i) {
+             std::copy_n(spd.rows[i], half, lu.rows[i]);
+           }
+           s21_detail::LuFactor(lu.rows.data(), half, pivots.data());
+           S21Matrix::Gemm(false, true, 1, a, b, 0, &c);
+         });
+
+  // The fixed kernels are used up to the first order where the general
+  // product is faster.
+  best.small_max = s21_detail::kSmallMax;
+  Set(best);
+  Buffer x(s21_detail::kSmallMax), y(s21_detail::kSmallMax);
+  for (int order = 1; order <= s21_detail::kSmallMax; ++order) {
+    const int calls = 20000;
+    double fixed = BestOf([&] {
+      for (int r = 0; r < calls; ++r) {
+        s21_detail::SmallMultiply(order, x.rows.data(), x.rows.data(),
+                                  y.rows.data());
+      }
+    });
+    double general = BestOf([&] {
+      for (int r = 0; r < calls; ++r) {
+        s21_detail::Multiply(x.rows.data(), x.rows.data(), y.rows.data(),
+                             order, order, order);
+      }
+    });
+    if (fixed > 1.03 * general) {
+      best.small_max = order - 1;
+      break;
+    }
+  }
+  Set(best);
+  S21Matrix::SetAccumulation(accumulation);
+  return best;
+}
+
+namespace s21_detail {
+
+long ParallelWork() { return parallel_work.load(std::memory_order_relaxed); }
+int GemmRows() { return gemm_rows.load(std::memory_order_relaxed); }
+int GemmCols() { return gemm_cols.load(std::memory_order_relaxed); }
+int CholeskyBlock() { return cholesky_block.load(std::memory_order_relaxed); }
+int SmallLimit() { return small_max.load(std::memory_order_relaxed); }
+
+}  // namespace s21_detail
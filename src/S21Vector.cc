@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cmath>
+
+#include "s21_kernels.h"
+#include "s21_vector.h"
+
+S21Vector::S21Vector() {}
+
+S21Vector::S21Vector(int size) {
+  if (size <= 0) S21_THROW(std::invalid_argument("Invalid argument"));
+  data_.assign(size, 0.0);
+}
+
+S21Vector::S21Vector(const S21Matrix& matrix) {
+  if (matrix.IsInvalid() || (matrix.rows_ != 1 && matrix.cols_ != 1)) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (matrix.rows_ == 1) {
+    data_.assign(matrix.matrix_[0], matrix.matrix_[0] + matrix.cols_);
+  } else {
+    data_.resize(matrix.rows_);
+    for (int i = 0; i < matrix.rows_; ++i) data_[i] = matrix.matrix_[i][0];
+  }
+}
+
+double& S21Vector::operator()(int index) {
+  if (index < 0 || index >= GetSize()) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  return data_[index];
+}
+
+double S21Vector::operator()(int index) const {
+  if (index < 0 || index >= GetSize()) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  return data_[index];
+}
+
+bool S21Vector::operator==(const S21Vector& other) const {
+  if (GetSize() != other.GetSize()) return false;
+  for (int i = 0; i < GetSize(); ++i) {
+    if (!(std::fabs(data_[i] - other.data_[i]) < 1e-07)) return false;
+  }
+  return true;
+}
+
+int S21Vector::GetSize() const { return static_cast<int>(data_.size()); }
+
+double* S21Vector::GetData() { return data_.data(); }
+
+const double* S21Vector::GetData() const { return data_.data(); }
+
+S21Matrix S21Vector::ToColumn() const {
+  S21Matrix result(GetSize(), 1, kS21Uninitialized);
+  for (int i = 0; i < GetSize(); ++i) result.matrix_[i][0] = data_[i];
+  return result;
+}
+
+S21Matrix S21Vector::ToRow() const {
+  S21Matrix result(1, GetSize(), kS21Uninitialized);
+  std::copy(data_.begin(), data_.end(), result.matrix_[0]);
+  return result;
+}
+
+double S21Vector::Dot(const S21Vector& other) const {
+  if (GetSize() != other.GetSize() || data_.empty()) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  // A single-row GEMV over the two buffers.
+  const double* row = data_.data();
+  double result;
+  s21_detail::Gemv(false, 1, GetSize(), 1, &row, other.GetData(), 0, &result);
+  return result;
+}
+
+void S21Vector::Gemv(bool transpose, double alpha, const S21Matrix& a,
+                     const S21Vector& x, double beta, S21Vector* y) {
+  if (a.IsInvalid() || y == nullptr) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  int in = transpose ? a.rows_ : a.cols_;
+  int out = transpose ? a.cols_ : a.rows_;
+  if (x.GetSize() != in || (beta != 0 && y->GetSize() != out)) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  if (y == &x) {
+    S21Vector result(*y);
+    Gemv(transpose, alpha, a, x, beta, &result);
+    *y = std::move(result);
+    return;
+  }
+  if (beta == 0) y->data_.resize(out);
+  s21_detail::Gemv(transpose, a.rows_, a.cols_, alpha, a.matrix_, x.GetData(),
+                   beta, y->GetData());
+}
+
+void S21Vector::Ger(double alpha, const S21Vector& x, const S21Vector& y,
+                    S21Matrix* a) {
+  if (a == nullptr || a->IsInvalid()) {
+    S21_THROW(std::invalid_argument("Invalid matrix"));
+  }
+  if (x.GetSize() != a->rows_ || y.GetSize() != a->cols_) {
+    S21_THROW(std::invalid_argument("Invalid argument"));
+  }
+  a->touch();
+  s21_detail::Ger(a->rows_, a->cols_, alpha, x.GetData(), y.GetData(),
+                  a->matrix_);
+}
+
+S21Vector operator*(const S21Matrix& a, const S21Vector& x) {
+  S21Vector y;
+  S21Vector::Gemv(false, 1, a, x, 0, &y);
+  return y;
+}
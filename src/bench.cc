@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "s21_distributed.h"
+#include "s21_elementwise.h"
+#include "s21_matrix_oop.h"
+#include "s21_numa.h"
+#include "s21_parallel.h"
+#include "s21_small.h"
+#include "s21_vector.h"
+
+// Prints one line per benchmark: name, best time over `repeats` runs in
+// milliseconds and an optional derived metric.
+static double Measure(int repeats, const std::function<void()>& body) {
+  double best = 1e300;
+  for (int r = 0; r < repeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+static void Report(const std::string& name, double ms,
+                   const std::string& metric = "") {
+  std::printf("%-40s %12.3f ms  %s\n", name.c_str(), ms, metric.c_str());
+}
+
+// Allocation plus a parallel read-modify-write sweep of an n x n matrix
+// under each placement policy. On a multi-socket node the sweep bandwidth
+// shows how much traffic stays node-local.
+static void BenchNuma(int n) {
+  struct Case {
+    const char* name;
+    S21NumaPolicy policy;
+  };
+  const Case cases[] = {{"default", S21NumaPolicy::kDefault},
+                        {"interleave", S21NumaPolicy::kInterleave},
+                        {"first_touch", S21NumaPolicy::kParallelFirstTouch},
+                        {"tiles", S21NumaPolicy::kNodeLocalTiles}};
+  S21Numa::SetThreadPinning(true);
+  S21Numa::SetMinBytes(0);
+  for (const Case& c : cases) {
+    S21Numa::SetPolicy(c.policy);
+    double alloc_ms = Measure(3, [n] { S21Matrix m(n, n); });
+    // Read-only sweep through the const accessor: workers must not call
+    // the writing operator(), which unshares and drops the fingerprint.
+    S21Matrix m(n, n);
+    const S21Matrix& view = m;
+    std::vector<double> row_sums(n);
+    double sweep_ms = Measure(5, [&view, &row_sums, n] {
+      s21_detail::ParallelFor(0, n, s21_detail::GrainFor(n),
+                              [&view, &row_sums, n](int lo, int hi) {
+                                for (int i = lo; i < hi; ++i) {
+                                  const double* row = &view(i, 0);
+                                  double sum = 0;
+                                  for (int j = 0; j < n; ++j) sum += row[j];
+                                  row_sums[i] = sum;
+                                }
+                              });
+    });
+    double gbps = 1.0 * n * n * sizeof(double) / (sweep_ms * 1e6);
+    Report(std::string("numa/alloc/") + c.name, alloc_ms);
+    Report(std::string("numa/sweep/") + c.name, sweep_ms,
+           std::to_string(gbps) + " GB/s");
+  }
+  S21Numa::SetPolicy(S21NumaPolicy::kDefault);
+  S21Numa::SetThreadPinning(false);
+  S21Numa::SetMinBytes(std::size_t(1) << 22);
+}
+
+// Passes an n x n matrix by value through a chain of readers with
+// copy-on-write off and on; only the last step writes to its copy.
+static S21Matrix ReadOnlyStep(S21Matrix m) { return m; }
+
+static void BenchCopyOnWrite(int n) {
+  S21Matrix source(n, n);
+  for (int flag = 0; flag < 2; ++flag) {
+    S21Matrix::SetCopyOnWrite(flag != 0);
+    double ms = Measure(5, [&source] {
+      S21Matrix m = source;
+      for (int step = 0; step < 8; ++step) m = ReadOnlyStep(m);
+      m(0, 0) = 1;
+    });
+    Report(flag ? "cow/copy_chain/on" : "cow/copy_chain/off", ms);
+  }
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+// A^64 by repeated operator*= against Power, and Exp on the same matrix.
+static void BenchPower(int n) {
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) a(i, j) = ((i * 7 + j * 3) % 11 - 5) * 1e-3;
+  }
+  Report("power/loop/64", Measure(1, [&a] {
+           S21Matrix result(a);
+           for (int k = 1; k < 64; ++k) result *= a;
+         }));
+  Report("power/squaring/64", Measure(3, [&a] { a.Power(64); }));
+  Report("power/exp", Measure(3, [&a] { a.Exp(); }));
+}
+
+// Built-in reductions against a scalar loop over operator().
+static void BenchReduce(int n) {
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) a(i, j) = std::sin(i + 0.5 * j);
+  }
+  const S21Matrix& view = a;
+  volatile double sink = 0;
+  Report("reduce/loop/frobenius", Measure(3, [&] {
+           double sum = 0;
+           for (int i = 0; i < n; ++i) {
+             for (int j = 0; j < n; ++j) sum += view(i, j) * view(i, j);
+           }
+           sink = std::sqrt(sum);
+         }));
+  Report("reduce/frobenius", Measure(3, [&] { sink = a.FrobeniusNorm(); }));
+  Report("reduce/sum", Measure(3, [&] { sink = a.Sum(); }));
+  Report("reduce/one_norm", Measure(3, [&] { sink = a.OneNorm(); }));
+  Report("reduce/inf_norm", Measure(3, [&] { sink = a.InfNorm(); }));
+  Report("reduce/two_norm_estimate",
+         Measure(3, [&] { sink = a.TwoNormEstimate(); }));
+  (void)sink;
+}
+
+// Matrix-vector products: S21Vector GEMV in both orientations, GER, and
+// the n x 1 S21Matrix path.
+static void BenchGemv(int n) {
+  S21Matrix a(n, n);
+  S21Vector x(n), y(n);
+  S21Matrix column(n, 1);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) a(i, j) = std::sin(i + 0.5 * j);
+    x(i) = column(i, 0) = std::cos(i);
+  }
+  double gflop = 2.0 * n * n / 1e9;
+  auto rate = [gflop](double ms) {
+    return std::to_string(gflop / (ms * 1e-3)) + " GFLOP/s";
+  };
+  double ms = Measure(5, [&] { S21Vector::Gemv(false, 1, a, x, 0, &y); });
+  Report("gemv/vector", ms, rate(ms));
+  ms = Measure(5, [&] { S21Vector::Gemv(true, 1, a, x, 0, &y); });
+  Report("gemv/vector_transposed", ms, rate(ms));
+  ms = Measure(5, [&] { S21Vector::Ger(1e-3, x, y, &a); });
+  Report("ger/vector", ms, rate(ms));
+  ms = Measure(5, [&] { S21Matrix product = a * column; });
+  Report("gemv/matrix_column", ms, rate(ms));
+}
+
+// C = alpha * A^T * B + beta * C through the operator chain and through
+// one fused Gemm call.
+static void BenchGemm(int n) {
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = std::sin(i + 0.5 * j);
+      b(i, j) = std::cos(i - 0.25 * j);
+    }
+  }
+  double gflop = 2.0 * n * n * n / 1e9;
+  double ms = Measure(3, [&] {
+    S21Matrix product = a.Transpose() * b;
+    product.MulNumber(0.5);
+    c.MulNumber(0.25);
+    c.SumMatrix(product);
+  });
+  Report("gemm/operator_chain", ms,
+         std::to_string(gflop / (ms * 1e-3)) + " GFLOP/s");
+  ms = Measure(3, [&] { S21Matrix::Gemm(true, false, 0.5, a, b, 0.25, &c); });
+  Report("gemm/fused", ms, std::to_string(gflop / (ms * 1e-3)) + " GFLOP/s");
+}
+
+// MulMatrix under each accumulation policy, and Kahan summation written
+// by hand through operator() for comparison.
+static void BenchAccumulation(int n) {
+  S21Matrix a(n, n), b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = std::sin(i + 0.5 * j);
+      b(i, j) = std::cos(i - 0.25 * j);
+    }
+  }
+  const S21Matrix& left = a;
+  const S21Matrix& right = b;
+  Report("accumulation/manual_kahan", Measure(1, [&] {
+           S21Matrix c(n, n);
+           for (int i = 0; i < n; ++i) {
+             for (int j = 0; j < n; ++j) {
+               double sum = 0, carry = 0;
+               for (int p = 0; p < n; ++p) {
+                 double y = left(i, p) * right(p, j) - carry;
+                 double t = sum + y;
+                 carry = (t - sum) - y;
+                 sum = t;
+               }
+               c(i, j) = sum;
+             }
+           }
+         }));
+  const struct {
+    const char* name;
+    S21Accumulation mode;
+  } modes[] = {{"accumulation/fast", S21Accumulation::kFast},
+               {"accumulation/compensated", S21Accumulation::kCompensated},
+               {"accumulation/two_sum", S21Accumulation::kTwoSum}};
+  for (const auto& mode : modes) {
+    S21Matrix::SetAccumulation(mode.mode);
+    Report(mode.name, Measure(3, [&] { S21Matrix c = a * b; }));
+  }
+  S21Matrix::SetAccumulation(S21Accumulation::kFast);
+}
+
+static void BenchDistributed(int n) {
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) a(i, j) = std::sin(i + 0.5 * j) + (i == j);
+  }
+  // Whole runs including fork, scatter and gather, so small sizes mostly
+  // measure the communication.
+  for (int processes : {1, 2, 4}) {
+    double ms = Measure(3, [&] {
+      S21SocketTransport::RunForked(processes, [&](S21Transport& transport) {
+        auto da = S21DistributedMatrix::Scatter(transport, a);
+        da.MulMatrix(da).Gather();
+      });
+    });
+    Report("distributed/summa_p" + std::to_string(processes), ms);
+    ms = Measure(3, [&] {
+      S21SocketTransport::RunForked(processes, [&](S21Transport& transport) {
+        S21DistributedMatrix::Scatter(transport, a).LuFactor();
+      });
+    });
+    Report("distributed/lu_p" + std::to_string(processes), ms);
+  }
+}
+
+// Fixed-order kernels called directly, through the order table and
+// through S21Matrix, 100000 calls each. The first two differ only by the
+// dispatch; the third adds validation and the result allocation.
+template <int N>
+static void BenchSmallOrder() {
+  const int calls = 100000;
+  S21Matrix a(N, N);
+  double data[N][N], product[N][N];
+  double* rows[N];
+  double* out[N];
+  for (int i = 0; i < N; ++i) {
+    for (int j = 0; j < N; ++j) {
+      data[i][j] = a(i, j) = std::sin(i + 0.5 * j) + (i == j);
+    }
+    rows[i] = data[i];
+    out[i] = product[i];
+  }
+  volatile double sink = 0;
+  std::string suffix = "_n" + std::to_string(N);
+  Report("small/det_fixed" + suffix, Measure(5, [&] {
+           for (int r = 0; r < calls; ++r) {
+             sink = sink + s21_detail::FixedDeterminant<N>(rows);
+           }
+         }));
+  Report("small/det_dispatch" + suffix, Measure(5, [&] {
+           double determinant = 0;
+           for (int r = 0; r < calls; ++r) {
+             s21_detail::SmallDeterminant(N, rows, &determinant);
+             sink = sink + determinant;
+           }
+         }));
+  Report("small/det_matrix" + suffix, Measure(5, [&] {
+           for (int r = 0; r < calls; ++r) sink = sink + a.Determinant();
+         }));
+  Report("small/mul_fixed" + suffix, Measure(5, [&] {
+           for (int r = 0; r < calls; ++r) {
+             s21_detail::FixedMultiply<N>(rows, rows, out);
+             sink = sink + out[0][0];
+           }
+         }));
+  Report("small/mul_dispatch" + suffix, Measure(5, [&] {
+           for (int r = 0; r < calls; ++r) {
+             s21_detail::SmallMultiply(N, rows, rows, out);
+             sink = sink + out[0][0];
+           }
+         }));
+  Report("small/mul_matrix" + suffix, Measure(5, [&] {
+           for (int r = 0; r < calls; ++r) sink = sink + (a * a)(0, 0);
+         }));
+  Report("small/inverse_matrix" + suffix, Measure(5, [&] {
+           for (int r = 0; r < calls; ++r) {
+             sink = sink + a.InverseMatrix()(0, 0);
+           }
+         }));
+}
+
+static void BenchSmall() {
+  BenchSmallOrder<2>();
+  BenchSmallOrder<3>();
+  BenchSmallOrder<4>();
+  BenchSmallOrder<8>();
+}
+
+// SPD inverse through Cholesky against the LU solve with the identity,
+// the general route of the same size.
+static void BenchCholesky(int n) {
+  S21Matrix b(n, n), identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) b(i, j) = std::sin(i * 5 + j * 2 + 1);
+    identity(i, i) = 1;
+  }
+  S21Matrix a = b * b.Transpose();
+  for (int i = 0; i < n; ++i) {
+    a(i, i) += 1;
+    for (int j = 0; j < i; ++j) a(j, i) = a(i, j);
+  }
+  Report("inverse/spd_cholesky", Measure(3, [&] { a.InverseMatrix(); }));
+  Report("inverse/lu_solve", Measure(3, [&] { a.Solve(identity); }));
+}
+
+// Elementwise kernels against the same loops written over operator().
+static void BenchElementwise(int n) {
+  S21Matrix a(n, n), b(n, n), out(n, n), row(1, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = std::sin(i + 0.5 * j);
+      b(i, j) = 2 + std::cos(i - 0.25 * j);
+    }
+    row(0, i) = i;
+  }
+  Report("elementwise/hadamard_indexed", Measure(3, [&] {
+           for (int i = 0; i < n; ++i) {
+             for (int j = 0; j < n; ++j) out(i, j) = a(i, j) * b(i, j);
+           }
+         }));
+  Report("elementwise/hadamard", Measure(3, [&] {
+           S21Elementwise::HadamardMul(a, b, &out);
+         }));
+  Report("elementwise/broadcast_add_row", Measure(3, [&] {
+           S21Elementwise::BroadcastAdd(a, row, &out);
+         }));
+  auto fused = [](double x) { return 0.5 * x * x + 2 * x - 1; };
+  Report("elementwise/map_fused", Measure(3, [&] {
+           S21Elementwise::Map(a, fused, &out);
+         }));
+  int m = static_cast<int>(std::sqrt(n));
+  S21Matrix small(m, m), kron;
+  Report("elementwise/kronecker", Measure(3, [&] {
+           S21Elementwise::Kronecker(small, small, &kron);
+         }));
+}
+
+int main(int argc, char* argv[]) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 2048;
+  std::printf("# nodes: %d, threads: %d, n: %d\n", S21Numa::NodeCount(),
+              s21_detail::WorkerCount(), n);
+  BenchNuma(n);
+  BenchCopyOnWrite(n);
+  BenchPower(std::min(n, 256));
+  BenchReduce(n);
+  BenchGemv(n);
+  BenchGemm(std::min(n, 512));
+  BenchAccumulation(std::min(n, 512));
+  BenchDistributed(std::min(n, 512));
+  BenchSmall();
+  BenchCholesky(std::min(n, 512));
+  BenchElementwise(n);
+  return 0;
+}
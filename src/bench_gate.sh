@@ -0,0 +1,32 @@
+#!/bin/sh
+# Compares two outputs of ./bench and fails when a benchmark is slower than
+# baseline * (1 + tolerance). Comment lines and benchmarks that took under
+# 0.05 ms in the baseline are skipped.
+# Usage: bench_gate.sh baseline current [tolerance]
+
+baseline=$1
+current=$2
+tolerance=${3:-0.25}
+
+if [ ! -f "$baseline" ]; then
+  echo "no baseline $baseline, record one with make bench_baseline"
+  exit 1
+fi
+
+awk -v tolerance="$tolerance" '
+  /^#/ { next }
+  FNR == NR { base[$1] = $2; next }
+  ($1 in base) && base[$1] >= 0.05 {
+    ratio = $2 / base[$1]
+    status = ratio > 1 + tolerance ? "SLOWER" : "ok"
+    printf "%-40s %12.3f %12.3f %7.2fx  %s\n", $1, base[$1], $2, ratio, status
+    if (status == "SLOWER") failed++
+  }
+  END {
+    if (failed) {
+      printf "%d benchmark(s) regressed by more than %d%%\n", failed,
+             tolerance * 100
+      exit 1
+    }
+  }
+' "$baseline" "$current"
@@ -0,0 +1,246 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include "s21_reference.h"
+#include "s21_vector.h"
+
+// libFuzzer entry point for the differential checks: the input bytes pick
+// an operation, an accumulation mode, the shapes and the values, and any
+// disagreement with s21_reference aborts.
+
+using s21_reference::Dense;
+
+namespace {
+
+class Input {
+ public:
+  Input(const std::uint8_t* data, std::size_t size)
+      : data_(data), size_(size) {}
+
+  std::uint8_t Byte() { return position_ < size_ ? data_[position_++] : 0; }
+
+  // Any bit pattern, including NaN, infinities and subnormals. Large
+  // finite values are scaled down so that sums cannot overflow in one
+  // summation order but not in another.
+  double Raw() {
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) bits = bits << 8 | Byte();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isfinite(value) && std::fabs(value) > 1e100) {
+      value = std::ldexp(value, -800);
+    }
+    return value;
+  }
+
+  // Moderate values for the determinant and inverse checks.
+  double Moderate() {
+    std::int16_t bits = static_cast<std::int16_t>(Byte() << 8 | Byte());
+    return bits / 256.0;
+  }
+
+  Dense Fill(int rows, int cols, bool raw) {
+    Dense result(rows, cols);
+    for (double& value : result.values) value = raw ? Raw() : Moderate();
+    return result;
+  }
+
+ private:
+  const std::uint8_t* data_;
+  std::size_t size_;
+  std::size_t position_ = 0;
+};
+
+void Check(bool ok, const char* what) {
+  if (!ok) {
+    std::fprintf(stderr, "mismatch against the reference: %s\n", what);
+    std::abort();
+  }
+}
+
+double HadamardBound(const Dense& a) {
+  double bound = 1;
+  for (int i = 0; i < a.rows; ++i) {
+    double norm = 0;
+    for (int j = 0; j < a.cols; ++j) norm += a(i, j) * a(i, j);
+    bound *= std::sqrt(norm);
+  }
+  return bound;
+}
+
+void CheckProduct(Input& input, int m, int k, int n) {
+  Dense a = input.Fill(m, k, true), b = input.Fill(k, n, true);
+  S21Matrix product = a.ToMatrix() * b.ToMatrix();
+  Check(s21_reference::Matches(product, s21_reference::Mul(a, b),
+                               s21_reference::AbsMul(a, b), 2 * k * 2.3e-16),
+        "product");
+  if (n == 1) {
+    S21Vector y = a.ToMatrix() * S21Vector(b.ToMatrix());
+    Check(s21_reference::Matches(y.ToColumn(), s21_reference::Mul(a, b),
+                                 s21_reference::AbsMul(a, b),
+                                 2 * k * 2.3e-16),
+          "gemv");
+  }
+}
+
+void CheckGemm(Input& input, int m, int k, int n) {
+  bool trans_a = input.Byte() & 1, trans_b = input.Byte() & 1;
+  Dense a = input.Fill(m, k, false), b = input.Fill(k, n, false);
+  Dense c = input.Fill(m, n, false);
+  double alpha = input.Moderate(), beta = input.Moderate();
+  Dense expected =
+      s21_reference::Sum(s21_reference::MulNumber(s21_reference::Mul(a, b),
+                                                  alpha),
+                         s21_reference::MulNumber(c, beta));
+  Dense scale = s21_reference::MulNumber(s21_reference::AbsMul(a, b),
+                                         std::fabs(alpha));
+  for (std::size_t i = 0; i < scale.values.size(); ++i) {
+    scale.values[i] += std::fabs(beta * c.values[i]);
+  }
+  S21Matrix result = c.ToMatrix();
+  S21Matrix::Gemm(trans_a, trans_b, alpha,
+                  (trans_a ? s21_reference::Transpose(a) : a).ToMatrix(),
+                  (trans_b ? s21_reference::Transpose(b) : b).ToMatrix(),
+                  beta, &result);
+  Check(s21_reference::Matches(result, expected, scale, 4 * (k + 2) * 2.3e-16),
+        "gemm");
+}
+
+void CheckElementwise(Input& input, int m, int n) {
+  Dense a = input.Fill(m, n, true), b = input.Fill(m, n, true);
+  double number = input.Raw();
+  S21Matrix left = a.ToMatrix(), right = b.ToMatrix();
+  Check(s21_reference::Matches(left + right, s21_reference::Sum(a, b)), "sum");
+  Check(s21_reference::Matches(left - right, s21_reference::Sub(a, b)), "sub");
+  Check(s21_reference::Matches(left * number,
+                               s21_reference::MulNumber(a, number)),
+        "mul_number");
+  Check(s21_reference::Matches(left.Transpose(), s21_reference::Transpose(a)),
+        "transpose");
+}
+
+// Square input shaped so that every Determinant, InverseMatrix and Solve
+// dispatch branch is reached: dense, diagonal, upper and lower
+// triangular, banded (two sub-, one superdiagonal), symmetric
+// (indefinite) and symmetric made diagonally dominant (positive
+// definite). Orders 9 and 10 pass SmallLimit() into the structured
+// kernels; at order 10 the cofactor reference is only affordable for the
+// determinant.
+Dense FillSquare(Input& input, int n) {
+  int kind = input.Byte() % 7;
+  Dense a = input.Fill(n, n, false);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      bool keep = kind == 0 || kind >= 5 || (kind == 1 && i == j) ||
+                  (kind == 2 && j >= i) || (kind == 3 && j <= i) ||
+                  (kind == 4 && i - j <= 2 && j - i <= 1);
+      if (!keep) a(i, j) = 0;
+      if (kind >= 5 && j > i) a(i, j) = a(j, i);
+    }
+    if (kind == 6) a(i, i) = std::fabs(a(i, i)) + 128.0 * n;
+  }
+  return a;
+}
+
+void CheckSquare(Input& input, int n) {
+  Dense a = FillSquare(input, n);
+  S21Matrix matrix = a.ToMatrix();
+  double expected = s21_reference::Determinant(a);
+  double bound = HadamardBound(a);
+  Check(std::fabs(matrix.Determinant() - expected) <= 1e-11 * bound + 1e-300,
+        "determinant");
+  if (n > 9) return;
+  if (std::fabs(expected) > 1e-7 && std::fabs(expected) < 1e-5) return;
+  bool reference_throws = false, optimized_throws = false;
+  Dense inverse;
+  S21Matrix optimized;
+  try {
+    inverse = s21_reference::InverseMatrix(a);
+  } catch (const std::invalid_argument&) {
+    reference_throws = true;
+  }
+  try {
+    optimized = matrix.InverseMatrix();
+  } catch (const std::invalid_argument&) {
+    optimized_throws = true;
+  }
+  Check(reference_throws == optimized_throws, "inverse singularity");
+  if (reference_throws) return;
+  double condition = matrix.OneNorm() * optimized.OneNorm();
+  if (condition > 1e10) return;
+  double inverse_max = 0;
+  for (double value : inverse.values) {
+    inverse_max = std::max(inverse_max, std::fabs(value));
+  }
+  Dense scale(n, n);
+  for (double& value : scale.values) value = inverse_max * condition;
+  Check(s21_reference::Matches(optimized, inverse, scale, 1e-12), "inverse");
+
+  Dense b = input.Fill(n, 1, false);
+  double b_max = 0;
+  for (double value : b.values) b_max = std::max(b_max, std::fabs(value));
+  Dense solve_scale(n, 1);
+  for (double& value : solve_scale.values) {
+    value = n * inverse_max * b_max * condition;
+  }
+  Check(s21_reference::Matches(matrix.Solve(b.ToMatrix()),
+                               s21_reference::Mul(inverse, b), solve_scale,
+                               1e-12),
+        "solve");
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t size) {
+  Input input(data, size);
+  int operation = input.Byte() % 4;
+  S21Matrix::SetAccumulation(static_cast<S21Accumulation>(input.Byte() % 3));
+  int m = 1 + input.Byte() % 8, k = 1 + input.Byte() % 8;
+  int n = 1 + input.Byte() % 8;
+  switch (operation) {
+    case 0:
+      CheckProduct(input, m, k, n);
+      break;
+    case 1:
+      CheckGemm(input, m, k, n);
+      break;
+    case 2:
+      CheckElementwise(input, m, n);
+      break;
+    default:
+      CheckSquare(input, 1 + (m + 8 * k) % 10);
+      break;
+  }
+  S21Matrix::SetAccumulation(S21Accumulation::kFast);
+  return 0;
+}
+
+#ifdef S21_FUZZ_STANDALONE
+// Without libFuzzer: replays the files given as arguments, or runs random
+// inputs when there are none.
+int main(int argc, char* argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    std::ifstream file(argv[i], std::ios::binary);
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                   std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+  }
+  if (argc > 1) return 0;
+  std::mt19937 rng(1);
+  std::vector<std::uint8_t> data(2048);
+  for (int run = 0; run < 20000; ++run) {
+    for (auto& byte : data) byte = static_cast<std::uint8_t>(rng());
+    LLVMFuzzerTestOneInput(data.data(), rng() % data.size());
+  }
+  std::printf("20000 random inputs matched the reference\n");
+  return 0;
+}
+#endif
@@ -0,0 +1,79 @@
+#ifndef S21_DISTRIBUTED_H_
+#define S21_DISTRIBUTED_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_transport.h"
+
+// Matrix spread over the processes of a transport in a 2D block-cyclic
+// layout: block (I, J) of size block x block lives on process
+// (I mod grid_rows, J mod grid_cols) of the grid_rows x grid_cols grid,
+// process (r, c) being rank r * grid_cols + c. Every method except the
+// getters is collective: all processes call it in the same order.
+class S21DistributedMatrix {
+ public:
+  // Zero matrix; grid_rows = 0 picks the most square grid.
+  S21DistributedMatrix(S21Transport& transport, int rows, int cols,
+                       int block = 64, int grid_rows = 0);
+  // Distributes `global`, which is only read on `root`.
+  static S21DistributedMatrix Scatter(S21Transport& transport,
+                                      const S21Matrix& global,
+                                      int block = 64, int root = 0,
+                                      int grid_rows = 0);
+  // The whole matrix on `root`, a default S21Matrix elsewhere.
+  S21Matrix Gather(int root = 0) const;
+
+  // this * other by SUMMA: for every block column of this, its owners
+  // broadcast the panel along process rows, the owners of the matching
+  // block row of other broadcast theirs along process columns, and every
+  // process multiplies the two panels into its tiles. Both operands must
+  // share the grid and block size.
+  S21DistributedMatrix MulMatrix(const S21DistributedMatrix& other) const;
+
+  // In-place right-looking LU with partial pivoting (P * A = L * U, unit
+  // lower L), factoring one block column at a time and updating the
+  // trailing tiles with the SUMMA pattern. Returns the determinant on
+  // every process, 0 for a singular matrix.
+  double LuFactor();
+  // Row i was swapped with row GetPivots()[i]; valid after LuFactor.
+  const std::vector<int>& GetPivots() const;
+
+  int GetRows() const;
+  int GetCols() const;
+  int GetBlock() const;
+  int GetGridRows() const;
+  int GetGridCols() const;
+  int GetLocalRows() const;
+  int GetLocalCols() const;
+
+ private:
+  S21Transport* transport_;
+  int rows_;
+  int cols_;
+  int block_;
+  int grid_rows_;
+  int grid_cols_;
+  int my_row_;
+  int my_col_;
+  int local_rows_;
+  int local_cols_;
+  std::vector<double> local_;  // local_rows_ x local_cols_, row-major
+  std::vector<int> pivots_;
+
+  double& At(int local_row, int local_col);
+  double* Row(int local_row);
+  bool OwnsRow(int row) const;
+  bool OwnsCol(int col) const;
+  int LocalRow(int row) const;
+  int LocalCol(int col) const;
+  int GlobalRow(int local_row) const;
+  int RankOf(int grid_row, int grid_col) const;
+  // Local rows / columns whose global index is below `bound`.
+  int RowsBelow(int bound) const;
+  int ColsBelow(int bound) const;
+  void Broadcast(std::vector<double>& data, int root, bool along_row) const;
+  void SwapRows(int first, int second, int col_begin, int col_end);
+};
+
+#endif  // S21_DISTRIBUTED_H_
@@ -0,0 +1,54 @@
+#ifndef S21_ELEMENTWISE_H_
+#define S21_ELEMENTWISE_H_
+
+#include <functional>
+
+#include "s21_matrix_oop.h"
+
+// Elementwise kernels that write into a caller-provided *out. A matching
+// *out is overwritten in place; otherwise it is reallocated to the result
+// shape. *out may be one of the operands. Rows are split over threads and
+// the inner loops run over contiguous rows without bounds checks.
+class S21Elementwise {
+ public:
+  // (a.rows * b.rows) x (a.cols * b.cols) block matrix of a(i, j) * b.
+  static void Kronecker(const S21Matrix& a, const S21Matrix& b,
+                        S21Matrix* out);
+  // a .* b and a ./ b for matrices of the same shape.
+  static void HadamardMul(const S21Matrix& a, const S21Matrix& b,
+                          S21Matrix* out);
+  static void HadamardDiv(const S21Matrix& a, const S21Matrix& b,
+                          S21Matrix* out);
+  // a + b and a .* b where b is a's shape, a 1 x cols row applied to every
+  // row, or a rows x 1 column applied to every column.
+  static void BroadcastAdd(const S21Matrix& a, const S21Matrix& b,
+                           S21Matrix* out);
+  static void BroadcastMul(const S21Matrix& a, const S21Matrix& b,
+                           S21Matrix* out);
+  // out(i, j) = fn(a(i, j)) in one pass, so a composed lambda costs a
+  // single sweep. fn is called from several threads at once.
+  template <class Fn>
+  static void Map(const S21Matrix& a, Fn fn, S21Matrix* out);
+
+ private:
+  static void Prepare(const S21Matrix& a, int rows, int cols,
+                      S21Matrix* out);
+  // Calls row(a row, the matching *out row) for every row, in parallel.
+  static void ForEachRow(
+      const S21Matrix& a, S21Matrix* out,
+      const std::function<void(const double*, double*)>& row);
+  template <class Op>
+  static void Broadcast(const S21Matrix& a, const S21Matrix& b, Op op,
+                        S21Matrix* out);
+};
+
+template <class Fn>
+void S21Elementwise::Map(const S21Matrix& a, Fn fn, S21Matrix* out) {
+  Prepare(a, a.rows_, a.cols_, out);
+  int cols = a.cols_;
+  ForEachRow(a, out, [&fn, cols](const double* x, double* y) {
+    for (int j = 0; j < cols; ++j) y[j] = fn(x[j]);
+  });
+}
+
+#endif  // S21_ELEMENTWISE_H_
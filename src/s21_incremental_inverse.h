@@ -0,0 +1,44 @@
+#ifndef S21_INCREMENTAL_INVERSE_H_
+#define S21_INCREMENTAL_INVERSE_H_
+
+#include "s21_matrix_oop.h"
+
+// Keeps the inverse and determinant of a square matrix up to date under
+// row, column and low-rank modifications in O(n^2 * k) per update
+// (Sherman-Morrison-Woodbury and the matrix determinant lemma). Every
+// `refactor_interval` updates both are recomputed from scratch to stop
+// rounding errors from accumulating. An update that throws, because the
+// result would be singular or storage ran out, leaves the state as it was.
+class S21IncrementalInverse {
+ public:
+  explicit S21IncrementalInverse(const S21Matrix& matrix,
+                                 int refactor_interval = 64);
+
+  // values is 1 x n
+  void ReplaceRow(int row, const S21Matrix& values);
+  // values is n x 1
+  void ReplaceCol(int col, const S21Matrix& values);
+  // matrix += u * v^T, u and v are n x k
+  void RankUpdate(const S21Matrix& u, const S21Matrix& v);
+  void Refactorize();
+
+  const S21Matrix& GetMatrix() const;
+  const S21Matrix& GetInverse() const;
+  double GetDeterminant() const;
+  int GetRefactorInterval() const;
+  void SetRefactorInterval(int refactor_interval);
+
+ private:
+  S21Matrix matrix_;
+  S21Matrix inverse_;
+  double determinant_;
+  int refactor_interval_;
+  int pending_updates_;
+  bool RefactorDue() const;
+  void Install(S21Matrix* matrix);
+  void ApplyRankOne(const double* u, const double* v);
+  static void Factorize(const S21Matrix& matrix, S21Matrix* inverse,
+                        double* determinant);
+};
+
+#endif  // S21_INCREMENTAL_INVERSE_H_
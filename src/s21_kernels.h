@@ -0,0 +1,57 @@
+#ifndef S21_KERNELS_H_
+#define S21_KERNELS_H_
+
+#include "s21_matrix_oop.h"
+
+// Dense kernels shared by S21Matrix and the classes built on top of it.
+// Matrices are passed as arrays of row pointers, like S21Matrix stores them.
+namespace s21_detail {
+
+// In-place LU factorization with partial pivoting: P * a = L * U with a
+// unit lower L. Row i was swapped with row pivots[i]. Returns the
+// determinant of a, 0 when a zero pivot is met.
+double LuFactor(double** a, int n, int* pivots);
+
+// Overwrites b (n x nrhs) with the solution of a * x = b, using the factors
+// produced by LuFactor.
+void LuSolve(double* const* lu, int n, const int* pivots, double** b,
+             int nrhs);
+
+// Writes the inverse of a into out (n x n) from the LuFactor factors.
+void LuInverse(double* const* lu, int n, const int* pivots, double** out);
+
+// In-place blocked Cholesky factorization a = L * L^T of a symmetric
+// matrix. Only the lower triangle is read and L overwrites it. Returns
+// false when a is not numerically positive definite; otherwise stores
+// det(a) in *determinant.
+bool CholeskyFactor(double** a, int n, double* determinant);
+
+// Writes a^-1 = L^-T * L^-1 into out (n x n) from the CholeskyFactor
+// factor l, exactly symmetric. out must not alias l.
+void CholeskyInverse(const double* const* l, int n, double** out);
+
+// Writes a (m x k) times b (k x n) into c (m x n). c must not alias a or b.
+void Multiply(const double* const* a, const double* const* b, double** c,
+              int m, int k, int n);
+
+// c = alpha * op(a) * op(b) + beta * c with op(x) = x or x^T, where op(a)
+// is m x k, op(b) is k x n and c is m x n. Transposed operands are read in
+// place. c is not read when beta is 0 and must not alias a or b.
+// `accumulation` selects how each dot product is summed.
+void Gemm(bool trans_a, bool trans_b, int m, int n, int k, double alpha,
+          const double* const* a, const double* const* b, double beta,
+          double** c,
+          S21Accumulation accumulation = S21Accumulation::kFast);
+
+// y = alpha * op(a) * x + beta * y for an m x n matrix a, op(a) = a or
+// a^T. y is not read when beta is 0. x and y must not overlap.
+void Gemv(bool transpose, int m, int n, double alpha, const double* const* a,
+          const double* x, double beta, double* y);
+
+// a += alpha * x * y^T for x of size m and y of size n.
+void Ger(int m, int n, double alpha, const double* x, const double* y,
+         double** a);
+
+}  // namespace s21_detail
+
+#endif  // S21_KERNELS_H_
@@ -1,11 +1,63 @@
+#ifndef S21_MATRIX_OOP_H_
+#define S21_MATRIX_OOP_H_
+
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 
+// Errors are reported by throwing `exception`. In -fno-exceptions builds
+// the message is printed and the process aborts instead; code built that
+// way handles expected failures through the Try* methods.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define S21_THROW(exception) throw exception
+#else
+#define S21_THROW(exception) \
+  (std::cerr << (exception).what() << std::endl, std::abort())
+#endif
+
+enum class S21Structure {
+  kGeneral,
+  kDiagonal,
+  kUpperTriangular,
+  kLowerTriangular,
+  kSymmetric,
+  kBanded
+};
+
+// How matrix products sum their dot products: plain (kFast),
+// with Neumaier compensation of the additions (kCompensated), or with
+// error-free TwoProduct/TwoSum transformations (kTwoSum), which is as
+// accurate as summing in twice the working precision.
+enum class S21Accumulation { kFast, kCompensated, kTwoSum };
+
+// Result of the non-throwing Try* methods: kInvalidMatrix where the
+// throwing method reports "Invalid matrix" for the arguments, kSingular
+// where it does so because the determinant is below 1e-6 in magnitude,
+// kOutOfMemory where it throws because storage could not be allocated.
+enum class S21Status { kOk, kInvalidMatrix, kSingular, kOutOfMemory };
+
+// Two elements a, b match when |a - b| < absolute, or
+// |a - b| <= relative * max(|a|, |b|), or they are at most `ulps` floating
+// point steps apart. The defaults are the EqMatrix rule.
+struct S21Tolerance {
+  double absolute = 1e-07;
+  double relative = 0;
+  std::int64_t ulps = 0;
+};
+
+// Tag for matrices whose every element is written before it is read:
+// skips the zero fill.
+struct S21Uninitialized {};
+inline constexpr S21Uninitialized kS21Uninitialized{};
+
 class S21Matrix {
  public:
   S21Matrix();  // Default constructor
   S21Matrix(int rows, int columns);
+  S21Matrix(int rows, int columns, S21Uninitialized);
   ~S21Matrix();  // Destructor
   S21Matrix(const S21Matrix& other);
   S21Matrix(S21Matrix&& other);
@@ -30,28 +82,118 @@ class S21Matrix {
   S21Matrix CalcComplements() const;
   S21Matrix Transpose() const;
   double Determinant() const;
-  S21Matrix InverseMatrix();
+  S21Matrix InverseMatrix() const;
+  // X with this * X = b by LU with partial pivoting.
+  S21Matrix Solve(const S21Matrix& b) const;
+  // Non-throwing InverseMatrix, Solve and Determinant sharing their
+  // kernels. The output is written only on kOk. TryDeterminant never
+  // reports kSingular: a singular matrix has a determinant.
+  S21Status TryInverse(S21Matrix* result) const noexcept;
+  S21Status TrySolve(const S21Matrix& b, S21Matrix* x) const noexcept;
+  S21Status TryDeterminant(double* result) const noexcept;
+  // A^k by repeated squaring; negative k raises the inverse.
+  S21Matrix Power(int k) const;
+  // Matrix exponential by scaling and squaring with a Pade approximant.
+  S21Matrix Exp() const;
+
+  // Eigenvalues of a symmetric matrix (ascending, n x 1); eigenvectors are
+  // stored as the columns of *vectors when it is given.
+  S21Matrix SymmetricEigen(S21Matrix* vectors = nullptr) const;
+  // Singular values (descending, min(rows, cols) x 1); thin U and V are
+  // stored in *u and *v when they are given.
+  S21Matrix SVD(S21Matrix* u = nullptr, S21Matrix* v = nullptr) const;
+
+  // Narrowest structure the stored values fit; for kBanded the bandwidths
+  // are written to *lower / *upper when they are given.
+  S21Structure DetectStructure(int* lower = nullptr,
+                               int* upper = nullptr) const;
 
   bool EqMatrix(const S21Matrix& other) const;
+  // Unlike EqMatrix, a size mismatch is just a false result.
+  bool ApproxEqual(const S21Matrix& other,
+                   const S21Tolerance& tolerance = S21Tolerance()) const;
+  // Exact value equality (0.0 == -0.0, NaN != NaN). Rejects in O(1) when
+  // both fingerprints are already computed and differ.
+  bool ExactEqual(const S21Matrix& other) const;
+  // Content hash of the size and values, cached until the next mutation.
+  // Writes through references taken before the call are not tracked.
+  std::uint64_t Fingerprint() const;
+
+  // Reductions run in parallel over rows; sums are pairwise (row-wise) or
+  // compensated (column-wise).
+  double Sum() const;
+  double Trace() const;
+  double Dot(const S21Matrix& other) const;  // sum of a(i, j) * b(i, j)
+  double MaxAbs() const;
+  double FrobeniusNorm() const;
+  S21Matrix RowSums() const;  // rows x 1
+  S21Matrix ColSums() const;  // 1 x cols
+  double OneNorm() const;     // largest absolute column sum
+  double InfNorm() const;     // largest absolute row sum
+  // Lower estimate of the spectral norm by power iteration on A^T A.
+  double TwoNormEstimate(int max_iterations = 50,
+                         double tolerance = 1e-06) const;
 
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulMatrix(const S21Matrix& other);
   void MulNumber(const double num);
+  // *c = alpha * op(a) * op(b) + beta * *c with op(x) = x or x^T (GEMM).
+  // Transposed operands are read in place and *c is updated without
+  // temporaries. With beta == 0, *c is resized to the product if needed.
+  static void Gemm(bool trans_a, bool trans_b, double alpha,
+                   const S21Matrix& a, const S21Matrix& b, double beta,
+                   S21Matrix* c);
 
   int GetRows() const;
   int GetCols() const;
   void SetRows(int rows);
   void SetCols(int cols);
 
+  // std::vector-like capacity: rows and columns can grow in place up to the
+  // reserved capacity, appends grow it geometrically.
+  void Reserve(int rows, int cols);
+  void AppendRow(const S21Matrix& row);  // 1 x cols
+  void AppendCol(const S21Matrix& col);  // rows x 1
+  void ShrinkToFit();
+  int GetRowCapacity() const;
+  int GetColCapacity() const;
+
+  // When on, copies share storage until one of them is written to.
+  // Affects copies made after the call.
+  static void SetCopyOnWrite(bool enabled);
+  static bool GetCopyOnWrite();
+
+  // Summation used by MulMatrix, operator* and Gemm; kFast by default.
+  static void SetAccumulation(S21Accumulation accumulation);
+  static S21Accumulation GetAccumulation();
+
  private:
+  friend class S21IncrementalInverse;
+  friend class S21StructuredMatrix;
+  friend class S21Vector;
+  friend class S21Elementwise;
+
   int rows_;
   int cols_;
+  int row_capacity_;
+  int col_capacity_;
   double** matrix_;
+  mutable std::atomic<std::uint64_t> fingerprint_{0};  // 0 = not computed
+  // Called before every write: unshares a copy-on-write block and drops
+  // the cached fingerprint.
+  void touch();
+  bool all_close(const S21Matrix& other, const S21Tolerance& tolerance) const;
   void remove_matrix();
   bool IsInvalid() const;
-  void create_matrix(int rows, int cols);
+  void create_matrix(int rows, int cols, bool zero = true);
   void copy_matrix(const S21Matrix& other);
+  void reallocate(int row_capacity, int col_capacity);
   int CheckMatrices(const S21Matrix& other) const;
+  S21Matrix product(const S21Matrix& other) const;
+  // TryInverse for a valid square matrix; throws when allocation fails.
+  S21Status invert(S21Matrix* result) const;
   void get_minor(int skip_row, int skip_col, const S21Matrix& minor) const;
-};
\ No newline at end of file
+};
+
+#endif  // S21_MATRIX_OOP_H_
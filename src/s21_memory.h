@@ -0,0 +1,39 @@
+#ifndef S21_MEMORY_H_
+#define S21_MEMORY_H_
+
+#include <atomic>
+#include <cstddef>
+
+// Storage for one matrix: a single block holding the row pointer table
+// followed by the 64-byte aligned, contiguous row-major data. Placement
+// follows the current S21Numa policy. Blocks are reference counted so that
+// copy-on-write matrices can share them.
+namespace s21_detail {
+
+// Sits right before the row pointer table.
+struct BlockHeader {
+  void* base;
+  std::size_t bytes;
+  std::atomic<int> refs;
+  int kind;
+};
+
+double** AllocateMatrix(int rows, int cols, bool zero);
+// Drops one reference, the last one frees the block.
+void FreeMatrix(double** matrix);
+
+inline BlockHeader* HeaderOf(double** matrix) {
+  return reinterpret_cast<BlockHeader*>(matrix) - 1;
+}
+
+inline void ShareMatrix(double** matrix) {
+  HeaderOf(matrix)->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline bool IsShared(double** matrix) {
+  return HeaderOf(matrix)->refs.load(std::memory_order_acquire) > 1;
+}
+
+}  // namespace s21_detail
+
+#endif  // S21_MEMORY_H_
@@ -0,0 +1,31 @@
+#ifndef S21_NUMA_H_
+#define S21_NUMA_H_
+
+#include <cstddef>
+
+// Placement of matrix storage on multi-socket machines.
+enum class S21NumaPolicy {
+  kDefault,             // whatever node the allocating thread runs on
+  kInterleave,          // pages spread round-robin over all nodes
+  kParallelFirstTouch,  // pages zeroed by the pinned worker of each row chunk
+  kNodeLocalTiles       // row tile t bound to node t
+};
+
+// Process-wide settings read by every S21Matrix allocation. Policies only
+// apply to matrices of at least GetMinBytes(); smaller ones use the heap.
+class S21Numa {
+ public:
+  static void SetPolicy(S21NumaPolicy policy);
+  static S21NumaPolicy GetPolicy();
+  static void SetMinBytes(std::size_t bytes);
+  static std::size_t GetMinBytes();
+
+  // Pins worker i of the parallel kernels and of the thread pools to the
+  // i-th CPU, CPUs ordered node by node, so row chunks stay on one node.
+  static void SetThreadPinning(bool enabled);
+  static bool GetThreadPinning();
+
+  static int NodeCount();
+};
+
+#endif  // S21_NUMA_H_
@@ -0,0 +1,74 @@
+#ifndef S21_PARALLEL_H_
+#define S21_PARALLEL_H_
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "s21_tuning.h"
+
+// Internal helpers shared by the multithreaded kernels.
+namespace s21_detail {
+
+inline int WorkerCount() {
+  unsigned count = std::thread::hardware_concurrency();
+  return count ? static_cast<int>(count) : 1;
+}
+
+// Rows per chunk so that each chunk carries at least ParallelWork() flops,
+// the smallest amount of work worth handing to a thread.
+inline int GrainFor(long work_per_item) {
+  if (work_per_item <= 0) return 1;
+  long grain = ParallelWork() / work_per_item;
+  return grain < 1 ? 1 : static_cast<int>(std::min<long>(grain, 1L << 30));
+}
+
+// Pins the calling thread as parallel worker `worker` when
+// S21Numa::SetThreadPinning is on (defined in S21Numa.cc).
+void PinWorker(int worker);
+
+// While alive, pins the calling thread as worker 0 when pinning is on and
+// then restores the affinity it had, so that ParallelFor's own chunk runs
+// pinned like the others without leaving the caller pinned (S21Numa.cc).
+class CallerPin {
+ public:
+  CallerPin();
+  ~CallerPin();
+  CallerPin(const CallerPin&) = delete;
+  CallerPin& operator=(const CallerPin&) = delete;
+
+ private:
+  alignas(8) unsigned char saved_[128];  // the caller's cpu_set_t
+  bool pinned_ = false;
+};
+
+// Splits [begin, end) into contiguous chunks of at least `grain` items and
+// calls fn(lo, hi) for each of them, the first chunk on the calling thread.
+template <class Fn>
+void ParallelFor(int begin, int end, int grain, Fn&& fn) {
+  int total = end - begin;
+  if (total <= 0) return;
+  int workers = std::min(WorkerCount(), total / std::max(grain, 1));
+  if (workers <= 1) {
+    fn(begin, end);
+    return;
+  }
+  int chunk = (total + workers - 1) / workers;
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (int lo = begin + chunk, worker = 1; lo < end; lo += chunk, ++worker) {
+    threads.emplace_back([&fn, lo, end, chunk, worker] {
+      PinWorker(worker);
+      fn(lo, std::min(lo + chunk, end));
+    });
+  }
+  {
+    CallerPin pin;
+    fn(begin, std::min(begin + chunk, end));
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace s21_detail
+
+#endif  // S21_PARALLEL_H_
@@ -0,0 +1,49 @@
+#ifndef S21_REFERENCE_H_
+#define S21_REFERENCE_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Frozen copy of the original S21Matrix algorithms (row-by-row triple loop,
+// cofactor expansion, adjugate inverse) on a plain row-major buffer. The
+// differential tests and the fuzz targets check every optimized path
+// against it; it is not part of the library.
+namespace s21_reference {
+
+struct Dense {
+  Dense(int rows = 0, int cols = 0);
+  explicit Dense(const S21Matrix& matrix);
+  double& operator()(int row, int col) { return values[row * cols + col]; }
+  double operator()(int row, int col) const {
+    return values[row * cols + col];
+  }
+  S21Matrix ToMatrix() const;
+
+  int rows;
+  int cols;
+  std::vector<double> values;
+};
+
+Dense Sum(const Dense& a, const Dense& b);
+Dense Sub(const Dense& a, const Dense& b);
+Dense MulNumber(const Dense& a, double number);
+Dense Mul(const Dense& a, const Dense& b);
+Dense Transpose(const Dense& a);
+// Exponential in the size: meant for n <= 8.
+double Determinant(const Dense& a);
+Dense CalcComplements(const Dense& a);
+// Throws std::invalid_argument when |det| < 1e-6, like InverseMatrix.
+Dense InverseMatrix(const Dense& a);
+// |a| |b| elementwise: scales the rounding error a product may carry.
+Dense AbsMul(const Dense& a, const Dense& b);
+
+// Elementwise |actual - expected| <= factor * scale(i, j) + tiny, with
+// NaN matching NaN and infinities matching by sign. An empty scale means
+// exact equality.
+bool Matches(const S21Matrix& actual, const Dense& expected,
+             const Dense& scale = Dense(), double factor = 0);
+
+}  // namespace s21_reference
+
+#endif  // S21_REFERENCE_H_
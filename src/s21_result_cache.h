@@ -0,0 +1,77 @@
+#ifndef S21_RESULT_CACHE_H_
+#define S21_RESULT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "s21_matrix_oop.h"
+
+// Opt-in memoization of the expensive S21Matrix operations, keyed by the
+// input fingerprint and verified with ExactEqual on every hit. Entries are
+// evicted in LRU order once the stored inputs and results exceed the byte
+// budget. All methods are thread-safe; the operation itself, the
+// ExactEqual check and the copy of a cached result run outside the lock.
+class S21ResultCache {
+ public:
+  struct Stats {
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t evictions;
+    std::size_t bytes;
+    std::size_t entries;
+  };
+
+  explicit S21ResultCache(std::size_t budget_bytes = std::size_t(64) << 20);
+
+  S21Matrix InverseMatrix(const S21Matrix& matrix);
+  S21Matrix CalcComplements(const S21Matrix& matrix);
+  double Determinant(const S21Matrix& matrix);
+
+  Stats GetStats() const;
+  void Clear();
+  void SetBudget(std::size_t budget_bytes);
+  std::size_t GetBudget() const;
+
+ private:
+  enum class Operation { kInverse, kComplements, kDeterminant };
+
+  struct Key {
+    Operation operation;
+    std::uint64_t fingerprint;
+    bool operator==(const Key& other) const {
+      return operation == other.operation && fingerprint == other.fingerprint;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+      return key.fingerprint ^ static_cast<std::size_t>(key.operation);
+    }
+  };
+  struct Entry {
+    Key key;
+    S21Matrix input;
+    S21Matrix result;
+    std::size_t bytes;
+  };
+
+  using EntryList = std::list<std::shared_ptr<const Entry>>;
+
+  mutable std::mutex mutex_;
+  // Entries are immutable and shared, so a lookup can keep one alive
+  // while it compares and copies it without the lock.
+  EntryList lru_;  // most recently used first
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+  std::size_t budget_;
+  Stats stats_;
+
+  template <class Compute>
+  S21Matrix Lookup(Operation operation, const S21Matrix& matrix,
+                   Compute compute);
+  void EvictLocked();
+};
+
+#endif  // S21_RESULT_CACHE_H_
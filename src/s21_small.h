@@ -0,0 +1,226 @@
+#ifndef S21_SMALL_H_
+#define S21_SMALL_H_
+
+#include <cmath>
+#include <utility>
+
+#include "s21_tuning.h"
+
+// Kernels for square matrices of a fixed order N <= kSmallMax. All loop
+// bounds are compile-time constants, so the loops are unrolled and the
+// pivot search compiles to conditional moves. The Small* functions pick the
+// kernel for a runtime order from a table and return false when there is
+// none or the order is above SmallLimit(), leaving the general code to
+// handle the matrix.
+namespace s21_detail {
+
+constexpr int kSmallMax = 8;
+
+template <int N>
+void FixedMultiply(const double* const* a, const double* const* b,
+                   double* const* c) {
+  double right[N][N];
+#pragma GCC unroll 8
+  for (int k = 0; k < N; ++k) {
+#pragma GCC unroll 8
+    for (int j = 0; j < N; ++j) right[k][j] = b[k][j];
+  }
+#pragma GCC unroll 8
+  for (int i = 0; i < N; ++i) {
+    double row[N] = {};
+#pragma GCC unroll 8
+    for (int k = 0; k < N; ++k) {
+      double factor = a[i][k];
+#pragma GCC unroll 8
+      for (int j = 0; j < N; ++j) row[j] += factor * right[k][j];
+    }
+#pragma GCC unroll 8
+    for (int j = 0; j < N; ++j) c[i][j] = row[j];
+  }
+}
+
+template <int N>
+void FixedTranspose(const double* const* a, double* const* out) {
+#pragma GCC unroll 8
+  for (int i = 0; i < N; ++i) {
+#pragma GCC unroll 8
+    for (int j = 0; j < N; ++j) out[j][i] = a[i][j];
+  }
+}
+
+// Gaussian elimination with partial pivoting on a local copy. Orders up to
+// 3 use the cofactor formulas instead.
+template <int N>
+double FixedDeterminant(const double* const* a) {
+  if constexpr (N == 1) {
+    return a[0][0];
+  } else if constexpr (N == 2) {
+    return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+  } else if constexpr (N == 3) {
+    return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+           a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+           a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+  } else {
+    double m[N][N];
+#pragma GCC unroll 8
+    for (int i = 0; i < N; ++i) {
+#pragma GCC unroll 8
+      for (int j = 0; j < N; ++j) m[i][j] = a[i][j];
+    }
+    double determinant = 1;
+#pragma GCC unroll 8
+    for (int k = 0; k < N; ++k) {
+      int pivot = k;
+#pragma GCC unroll 8
+      for (int i = k + 1; i < N; ++i) {
+        pivot = std::fabs(m[i][k]) > std::fabs(m[pivot][k]) ? i : pivot;
+      }
+#pragma GCC unroll 8
+      for (int j = 0; j < N; ++j) std::swap(m[k][j], m[pivot][j]);
+      double diagonal = m[k][k];
+      if (diagonal == 0) return 0;
+      determinant *= pivot == k ? diagonal : -diagonal;
+      double inv_diagonal = 1 / diagonal;
+#pragma GCC unroll 8
+      for (int i = k + 1; i < N; ++i) {
+        double factor = m[i][k] * inv_diagonal;
+#pragma GCC unroll 8
+        for (int j = k + 1; j < N; ++j) m[i][j] -= factor * m[k][j];
+      }
+    }
+    return determinant;
+  }
+}
+
+// Writes the inverse of a into out and returns the determinant of a. When
+// it is 0, out is left unspecified. Orders up to 3 use the adjugate,
+// larger ones Gauss-Jordan elimination with partial pivoting.
+template <int N>
+double FixedInverse(const double* const* a, double* const* out) {
+  if constexpr (N == 1) {
+    out[0][0] = 1 / a[0][0];
+    return a[0][0];
+  } else if constexpr (N == 2) {
+    double determinant = FixedDeterminant<2>(a);
+    double scale = 1 / determinant;
+    out[0][0] = a[1][1] * scale;
+    out[0][1] = -a[0][1] * scale;
+    out[1][0] = -a[1][0] * scale;
+    out[1][1] = a[0][0] * scale;
+    return determinant;
+  } else if constexpr (N == 3) {
+    double adjugate[3][3];
+#pragma GCC unroll 3
+    for (int i = 0; i < 3; ++i) {
+#pragma GCC unroll 3
+      for (int j = 0; j < 3; ++j) {
+        // Cofactor of a[j][i] from the cyclically following rows/columns.
+        int r0 = (j + 1) % 3, r1 = (j + 2) % 3;
+        int c0 = (i + 1) % 3, c1 = (i + 2) % 3;
+        adjugate[i][j] = a[r0][c0] * a[r1][c1] - a[r0][c1] * a[r1][c0];
+      }
+    }
+    double determinant = a[0][0] * adjugate[0][0] +
+                         a[0][1] * adjugate[1][0] + a[0][2] * adjugate[2][0];
+    double scale = 1 / determinant;
+#pragma GCC unroll 3
+    for (int i = 0; i < 3; ++i) {
+#pragma GCC unroll 3
+      for (int j = 0; j < 3; ++j) out[i][j] = adjugate[i][j] * scale;
+    }
+    return determinant;
+  } else {
+    double m[N][2 * N];
+#pragma GCC unroll 8
+    for (int i = 0; i < N; ++i) {
+#pragma GCC unroll 8
+      for (int j = 0; j < N; ++j) {
+        m[i][j] = a[i][j];
+        m[i][N + j] = i == j;
+      }
+    }
+    double determinant = 1;
+#pragma GCC unroll 8
+    for (int k = 0; k < N; ++k) {
+      int pivot = k;
+#pragma GCC unroll 8
+      for (int i = k + 1; i < N; ++i) {
+        pivot = std::fabs(m[i][k]) > std::fabs(m[pivot][k]) ? i : pivot;
+      }
+#pragma GCC unroll 16
+      for (int j = 0; j < 2 * N; ++j) std::swap(m[k][j], m[pivot][j]);
+      double diagonal = m[k][k];
+      if (diagonal == 0) return 0;
+      determinant *= pivot == k ? diagonal : -diagonal;
+      double inv_diagonal = 1 / diagonal;
+#pragma GCC unroll 16
+      for (int j = 0; j < 2 * N; ++j) m[k][j] *= inv_diagonal;
+#pragma GCC unroll 8
+      for (int i = 0; i < N; ++i) {
+        double factor = i == k ? 0 : m[i][k];
+#pragma GCC unroll 16
+        for (int j = 0; j < 2 * N; ++j) m[i][j] -= factor * m[k][j];
+      }
+    }
+#pragma GCC unroll 8
+    for (int i = 0; i < N; ++i) {
+#pragma GCC unroll 8
+      for (int j = 0; j < N; ++j) out[i][j] = m[i][N + j];
+    }
+    return determinant;
+  }
+}
+
+// Dispatch by table lookup on the order.
+inline bool SmallMultiply(int n, const double* const* a,
+                          const double* const* b, double* const* c) {
+  using Kernel = void (*)(const double* const*, const double* const*,
+                          double* const*);
+  static constexpr Kernel kKernels[kSmallMax + 1] = {
+      nullptr,           FixedMultiply<1>, FixedMultiply<2>,
+      FixedMultiply<3>, FixedMultiply<4>, FixedMultiply<5>,
+      FixedMultiply<6>, FixedMultiply<7>, FixedMultiply<8>};
+  if (n < 1 || n > SmallLimit()) return false;
+  kKernels[n](a, b, c);
+  return true;
+}
+
+inline bool SmallTranspose(int n, const double* const* a,
+                           double* const* out) {
+  using Kernel = void (*)(const double* const*, double* const*);
+  static constexpr Kernel kKernels[kSmallMax + 1] = {
+      nullptr,            FixedTranspose<1>, FixedTranspose<2>,
+      FixedTranspose<3>, FixedTranspose<4>, FixedTranspose<5>,
+      FixedTranspose<6>, FixedTranspose<7>, FixedTranspose<8>};
+  if (n < 1 || n > SmallLimit()) return false;
+  kKernels[n](a, out);
+  return true;
+}
+
+inline bool SmallDeterminant(int n, const double* const* a,
+                             double* determinant) {
+  using Kernel = double (*)(const double* const*);
+  static constexpr Kernel kKernels[kSmallMax + 1] = {
+      nullptr,              FixedDeterminant<1>, FixedDeterminant<2>,
+      FixedDeterminant<3>, FixedDeterminant<4>, FixedDeterminant<5>,
+      FixedDeterminant<6>, FixedDeterminant<7>, FixedDeterminant<8>};
+  if (n < 1 || n > SmallLimit()) return false;
+  *determinant = kKernels[n](a);
+  return true;
+}
+
+inline bool SmallInverse(int n, const double* const* a, double* const* out,
+                         double* determinant) {
+  using Kernel = double (*)(const double* const*, double* const*);
+  static constexpr Kernel kKernels[kSmallMax + 1] = {
+      nullptr,          FixedInverse<1>, FixedInverse<2>,
+      FixedInverse<3>, FixedInverse<4>, FixedInverse<5>,
+      FixedInverse<6>, FixedInverse<7>, FixedInverse<8>};
+  if (n < 1 || n > SmallLimit()) return false;
+  *determinant = kKernels[n](a, out);
+  return true;
+}
+
+}  // namespace s21_detail
+
+#endif  // S21_SMALL_H_
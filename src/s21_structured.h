@@ -0,0 +1,55 @@
+#ifndef S21_STRUCTURED_H_
+#define S21_STRUCTURED_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Square matrix that only stores the entries its structure allows:
+// n values for diagonal, n(n+1)/2 for triangular and symmetric (lower
+// half), (lower + upper + 1) per row for banded. Operations run only over
+// the stored entries.
+class S21StructuredMatrix {
+ public:
+  S21StructuredMatrix(S21Structure structure, int size, int lower = 0,
+                      int upper = 0);
+  // Packs `dense`, whose entries outside the structure must be zero (or
+  // mirror the lower half for kSymmetric).
+  S21StructuredMatrix(const S21Matrix& dense, S21Structure structure,
+                      int lower = 0, int upper = 0);
+
+  // Only entries inside the structure can be written.
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+  S21Structure GetStructure() const;
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+
+  S21Matrix ToDense() const;
+  // this * other (TRMM for triangular)
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  // X with this * X = other (TRSM for triangular)
+  S21Matrix Solve(const S21Matrix& other) const;
+  double Determinant() const;
+  S21Matrix InverseMatrix() const;
+  // Returns the determinant and, when |det| >= 1e-6, stores the inverse
+  // in *inverse; both come from a single factorization.
+  double Invert(S21Matrix* inverse) const;
+
+ private:
+  S21Structure structure_;
+  int size_;
+  int lower_;
+  int upper_;
+  std::vector<double> data_;
+  long Index(int row, int col) const;
+  int RowBegin(int row) const;
+  int RowEnd(int row) const;
+  double BandFactor(std::vector<double>& ab, std::vector<int>& pivots) const;
+  void BandSolve(const std::vector<double>& ab, const std::vector<int>& pivots,
+                 double** b, int cols) const;
+};
+
+#endif  // S21_STRUCTURED_H_
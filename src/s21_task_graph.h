@@ -0,0 +1,76 @@
+#ifndef S21_TASK_GRAPH_H_
+#define S21_TASK_GRAPH_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+// Builds a dependency graph of matrix operations and runs every node on the
+// pool as soon as its inputs are ready, so independent operations overlap.
+// Each call returns a handle to the future result. Failures and
+// cancellations propagate to everything that depends on the node. The
+// graph itself does not keep results alive: a node is freed once no
+// handle refers to it and all its dependents have run.
+class S21TaskGraph {
+ private:
+  struct Core;
+  struct Node;
+
+ public:
+  class Handle {
+   public:
+    Handle() = default;
+
+    // Block until the node has finished. Get rethrows the exception of a
+    // failed node and throws std::runtime_error for a cancelled one.
+    const S21Matrix& Get() const;
+    double GetScalar() const;  // result of Determinant
+    void Wait() const;
+    bool IsReady() const;
+    // Drops the node if it has not started yet; returns false otherwise.
+    bool Cancel() const;
+
+   private:
+    friend class S21TaskGraph;
+    std::shared_ptr<Node> node_;
+    explicit Handle(std::shared_ptr<Node> node);
+  };
+
+  using Operation =
+      std::function<S21Matrix(const std::vector<const S21Matrix*>& inputs)>;
+
+  explicit S21TaskGraph(S21ThreadPool& pool = S21ThreadPool::Shared());
+  ~S21TaskGraph();
+  S21TaskGraph(const S21TaskGraph&) = delete;
+  S21TaskGraph& operator=(const S21TaskGraph&) = delete;
+
+  Handle Input(S21Matrix matrix);
+  Handle Sum(const Handle& a, const Handle& b, int priority = 0);
+  Handle Sub(const Handle& a, const Handle& b, int priority = 0);
+  Handle Mul(const Handle& a, const Handle& b, int priority = 0);
+  Handle MulNumber(const Handle& a, double num, int priority = 0);
+  Handle Transpose(const Handle& a, int priority = 0);
+  Handle Inverse(const Handle& a, int priority = 0);
+  Handle Complements(const Handle& a, int priority = 0);
+  Handle Determinant(const Handle& a, int priority = 0);
+  Handle Apply(const std::vector<Handle>& inputs, Operation operation,
+               int priority = 0);
+
+  void WaitAll() const;
+  void CancelAll();
+
+ private:
+  std::shared_ptr<Core> core_;
+  std::vector<std::weak_ptr<Node>> nodes_;  // for WaitAll and CancelAll
+  void Track(const std::shared_ptr<Node>& node);
+  Handle AddNode(const std::vector<Handle>& inputs,
+                 std::function<void(Node&)> work, int priority);
+  static void Schedule(const std::shared_ptr<Node>& node);
+  static void Run(const std::shared_ptr<Node>& node);
+  static void Finish(const std::shared_ptr<Node>& node);
+};
+
+#endif  // S21_TASK_GRAPH_H_
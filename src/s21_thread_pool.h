@@ -0,0 +1,45 @@
+#ifndef S21_THREAD_POOL_H_
+#define S21_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads taking tasks by priority (higher first,
+// FIFO among equal priorities). Queued tasks are drained on destruction.
+class S21ThreadPool {
+ public:
+  explicit S21ThreadPool(int threads = 0);  // 0 means one per core
+  ~S21ThreadPool();
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+
+  void Submit(std::function<void()> task, int priority = 0);
+  int GetThreadCount() const;
+
+  static S21ThreadPool& Shared();
+
+ private:
+  struct Task {
+    int priority;
+    long sequence;
+    std::function<void()> run;
+    bool operator<(const Task& other) const {
+      if (priority != other.priority) return priority < other.priority;
+      return sequence > other.sequence;
+    }
+  };
+
+  std::vector<std::thread> workers_;
+  std::priority_queue<Task> queue_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  long next_sequence_;
+  bool stopping_;
+  void WorkerLoop();
+};
+
+#endif  // S21_THREAD_POOL_H_
@@ -0,0 +1,49 @@
+#ifndef S21_TRANSPORT_H_
+#define S21_TRANSPORT_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Point-to-point messaging between the processes of a distributed
+// computation. Messages between a pair of processes arrive in the order
+// they were sent; Send may block until the peer receives. Another
+// interconnect (TCP, MPI) plugs in by implementing this interface.
+class S21Transport {
+ public:
+  virtual ~S21Transport() = default;
+  virtual int GetRank() const = 0;
+  virtual int GetSize() const = 0;
+  virtual void Send(int peer, const void* data, std::size_t bytes) = 0;
+  virtual void Receive(int peer, void* data, std::size_t bytes) = 0;
+};
+
+// Transport over Unix domain stream sockets, one per pair of processes.
+class S21SocketTransport : public S21Transport {
+ public:
+  // Rendezvous of independently started processes: rank r listens on
+  // `directory`/s21-r.sock and connects to every lower rank.
+  S21SocketTransport(int rank, int size, const std::string& directory);
+  ~S21SocketTransport() override;
+  S21SocketTransport(const S21SocketTransport&) = delete;
+  S21SocketTransport& operator=(const S21SocketTransport&) = delete;
+
+  int GetRank() const override;
+  int GetSize() const override;
+  void Send(int peer, const void* data, std::size_t bytes) override;
+  void Receive(int peer, void* data, std::size_t bytes) override;
+
+  // Forks size - 1 children connected by socket pairs and runs body in
+  // all `size` processes, the calling one as rank 0. Children exit when
+  // body returns. True when body returned normally in every process.
+  static bool RunForked(int size,
+                        const std::function<void(S21Transport&)>& body);
+
+ private:
+  S21SocketTransport(int rank, std::vector<int> sockets);
+  int rank_;
+  std::vector<int> sockets_;  // sockets_[peer], -1 for rank_
+};
+
+#endif  // S21_TRANSPORT_H_
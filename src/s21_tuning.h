@@ -0,0 +1,49 @@
+#ifndef S21_TUNING_H_
+#define S21_TUNING_H_
+
+#include <string>
+
+// Machine-dependent parameters of the kernels.
+struct S21TuningParameters {
+  long parallel_work = 1L << 16;  // flops per thread chunk (serial below)
+  int gemm_rows = 4;              // rows of c that Gemm updates together
+  int gemm_cols = 512;            // width of a Gemm column block
+  int cholesky_block = 64;        // columns per Cholesky panel
+  int small_max = 8;              // largest order for the fixed kernels
+};
+
+// Process-wide kernel parameters. They start at the built-in defaults and
+// are replaced before main by the file at DefaultPath() when it exists.
+class S21Tuning {
+ public:
+  static S21TuningParameters Get();
+  // Throws std::invalid_argument for out-of-range values.
+  static void Set(const S21TuningParameters& parameters);
+  static void Reset();
+
+  // "name = value" lines; '#' comments and unknown names are skipped.
+  // Returns false, changing nothing, when the file cannot be read or holds
+  // an invalid value.
+  static bool Load(const std::string& path);
+  static bool Save(const std::string& path);
+  // $S21_TUNING_FILE, otherwise $HOME/.s21_matrix_tuning.
+  static std::string DefaultPath();
+
+  // Times the candidates of every parameter on order-n problems, keeping
+  // a candidate only when it beats the current choice by more than 3%.
+  // Applies the result and returns it.
+  static S21TuningParameters Tune(int n = 256);
+};
+
+namespace s21_detail {
+
+// Current values, read by the kernels on every call.
+long ParallelWork();
+int GemmRows();
+int GemmCols();
+int CholeskyBlock();
+int SmallLimit();
+
+}  // namespace s21_detail
+
+#endif  // S21_TUNING_H_
@@ -0,0 +1,43 @@
+#ifndef S21_VECTOR_H_
+#define S21_VECTOR_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Dense vector in one contiguous buffer, the operand type of the
+// matrix-vector kernels.
+class S21Vector {
+ public:
+  S21Vector();
+  explicit S21Vector(int size);
+  // Copies a rows x 1 or 1 x cols matrix.
+  explicit S21Vector(const S21Matrix& matrix);
+
+  double& operator()(int index);
+  double operator()(int index) const;
+  bool operator==(const S21Vector& other) const;
+
+  int GetSize() const;
+  double* GetData();
+  const double* GetData() const;
+
+  S21Matrix ToColumn() const;  // size x 1
+  S21Matrix ToRow() const;     // 1 x size
+  double Dot(const S21Vector& other) const;
+
+  // *y = alpha * op(a) * x + beta * *y with op(a) = a or a^T (GEMV).
+  // *y is resized when beta is 0; otherwise it must already fit.
+  static void Gemv(bool transpose, double alpha, const S21Matrix& a,
+                   const S21Vector& x, double beta, S21Vector* y);
+  // *a += alpha * x * y^T (GER).
+  static void Ger(double alpha, const S21Vector& x, const S21Vector& y,
+                  S21Matrix* a);
+
+ private:
+  std::vector<double> data_;
+};
+
+S21Vector operator*(const S21Matrix& a, const S21Vector& x);
+
+#endif  // S21_VECTOR_H_
@@ -1,5 +1,28 @@
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <random>
+#include <thread>
+
 #include "gtest/gtest.h"
+#include "s21_distributed.h"
+#include "s21_elementwise.h"
+#include "s21_incremental_inverse.h"
 #include "s21_matrix_oop.h"
+#include "s21_numa.h"
+#include "s21_reference.h"
+#include "s21_result_cache.h"
+#include "s21_structured.h"
+#include "s21_task_graph.h"
+#include "s21_tuning.h"
+#include "s21_vector.h"
 
 TEST(test_01, basic_constructor) {
   S21Matrix m;
@@ -765,7 +788,1692 @@ TEST(Test, Inverse) {
   EXPECT_THROW(B = A.InverseMatrix(), std::invalid_argument);
 }
 
+TEST(test_eigen, symmetric_values) {
+  S21Matrix A(3, 3);
+  double data[3][3] = {{2, -1, 0}, {-1, 2, -1}, {0, -1, 2}};
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) A(i, j) = data[i][j];
+
+  S21Matrix values = A.SymmetricEigen();
+
+  EXPECT_EQ(values.GetRows(), 3);
+  EXPECT_EQ(values.GetCols(), 1);
+  EXPECT_NEAR(values(0, 0), 2 - std::sqrt(2.0), 1e-12);
+  EXPECT_NEAR(values(1, 0), 2, 1e-12);
+  EXPECT_NEAR(values(2, 0), 2 + std::sqrt(2.0), 1e-12);
+}
+
+TEST(test_eigen, symmetric_vectors_reconstruct) {
+  const int n = 7;
+  S21Matrix A(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j <= i; j++) A(i, j) = A(j, i) = std::sin(i * 3 + j + 1);
+
+  S21Matrix V;
+  S21Matrix values = A.SymmetricEigen(&V);
+  S21Matrix D(n, n);
+  for (int i = 0; i < n; i++) D(i, i) = values(i, 0);
+
+  EXPECT_TRUE(A == V * D * V.Transpose());
+  S21Matrix I(n, n);
+  for (int i = 0; i < n; i++) I(i, i) = 1;
+  EXPECT_TRUE(V.Transpose() * V == I);
+}
+
+TEST(test_eigen, symmetric_vectors_several_panels) {
+  const int n = 75;
+  S21Matrix A(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j <= i; j++) A(i, j) = A(j, i) = std::sin(i * 3 + j + 1);
+
+  S21Matrix V;
+  S21Matrix values = A.SymmetricEigen(&V);
+  S21Matrix D(n, n);
+  for (int i = 0; i < n; i++) D(i, i) = values(i, 0);
+
+  EXPECT_TRUE(A == V * D * V.Transpose());
+  S21Matrix I(n, n);
+  for (int i = 0; i < n; i++) I(i, i) = 1;
+  EXPECT_TRUE(V.Transpose() * V == I);
+  EXPECT_TRUE(values == A.SymmetricEigen());
+}
+
+TEST(test_eigen, symmetric_error) {
+  S21Matrix A(2, 2);
+  A(0, 1) = 1;
+  EXPECT_THROW(A.SymmetricEigen(), std::invalid_argument);
+  S21Matrix B(2, 3);
+  EXPECT_THROW(B.SymmetricEigen(), std::invalid_argument);
+}
+
+TEST(test_eigen, svd_tall) {
+  S21Matrix A(4, 3);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 3; j++) A(i, j) = std::cos(i * 5 + j * 2);
+
+  S21Matrix U, V;
+  S21Matrix s = A.SVD(&U, &V);
+  S21Matrix S(3, 3);
+  for (int i = 0; i < 3; i++) S(i, i) = s(i, 0);
+
+  EXPECT_EQ(U.GetRows(), 4);
+  EXPECT_EQ(U.GetCols(), 3);
+  EXPECT_GE(s(0, 0), s(1, 0));
+  EXPECT_GE(s(1, 0), s(2, 0));
+  EXPECT_TRUE(A == U * S * V.Transpose());
+  EXPECT_TRUE(s == A.SVD());
+}
+
+TEST(test_eigen, svd_wide_rank_deficient) {
+  S21Matrix A(2, 4);
+  for (int j = 0; j < 4; j++) {
+    A(0, j) = j + 1;
+    A(1, j) = 2 * (j + 1);
+  }
+
+  S21Matrix U, V;
+  S21Matrix s = A.SVD(&U, &V);
+  S21Matrix S(2, 2);
+  for (int i = 0; i < 2; i++) S(i, i) = s(i, 0);
+  S21Matrix I(2, 2);
+  I(0, 0) = I(1, 1) = 1;
+
+  EXPECT_NEAR(s(0, 0), std::sqrt(150.0), 1e-12);
+  EXPECT_NEAR(s(1, 0), 0, 1e-12);
+  EXPECT_TRUE(A == U * S * V.Transpose());
+  EXPECT_TRUE(U.Transpose() * U == I);
+  EXPECT_TRUE(V.Transpose() * V == I);
+}
+
+static S21Matrix make_test_matrix(int n) {
+  S21Matrix m(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      m(i, j) = std::sin(i * 7 + j * 3 + 1) + (i == j ? n : 0);
+  return m;
+}
+
+TEST(test_incremental, replace_row_and_col) {
+  S21IncrementalInverse tracker(make_test_matrix(5));
+  S21Matrix row(1, 5), col(5, 1);
+  for (int j = 0; j < 5; j++) {
+    row(0, j) = j - 2.5;
+    col(j, 0) = 0.5 * j + 1;
+  }
+
+  tracker.ReplaceRow(2, row);
+  tracker.ReplaceCol(4, col);
+
+  S21Matrix expected = make_test_matrix(5);
+  for (int j = 0; j < 5; j++) expected(2, j) = row(0, j);
+  for (int i = 0; i < 5; i++) expected(i, 4) = col(i, 0);
+  EXPECT_TRUE(tracker.GetMatrix() == expected);
+  EXPECT_TRUE(tracker.GetInverse() == expected.InverseMatrix());
+  EXPECT_NEAR(tracker.GetDeterminant(), expected.Determinant(), 1e-9);
+}
+
+TEST(test_incremental, rank_update) {
+  S21IncrementalInverse tracker(make_test_matrix(4));
+  S21Matrix u(4, 2), v(4, 2);
+  for (int i = 0; i < 4; i++) {
+    u(i, 0) = i + 1;
+    u(i, 1) = std::cos(i);
+    v(i, 0) = 0.1 * i;
+    v(i, 1) = 1 - 0.2 * i;
+  }
+
+  tracker.RankUpdate(u, v);
+
+  S21Matrix expected = make_test_matrix(4) + u * v.Transpose();
+  EXPECT_TRUE(tracker.GetInverse() == expected.InverseMatrix());
+  EXPECT_NEAR(tracker.GetDeterminant(), expected.Determinant(), 1e-9);
+}
+
+TEST(test_incremental, refactorize_interval) {
+  S21IncrementalInverse tracker(make_test_matrix(3), 2);
+  S21Matrix row(1, 3);
+  for (int step = 0; step < 5; step++) {
+    for (int j = 0; j < 3; j++) row(0, j) = (j == step % 3) ? 4 : 0.5;
+    tracker.ReplaceRow(step % 3, row);
+  }
+  S21Matrix product = tracker.GetMatrix() * tracker.GetInverse();
+  S21Matrix I(3, 3);
+  for (int i = 0; i < 3; i++) I(i, i) = 1;
+  EXPECT_TRUE(product == I);
+  EXPECT_EQ(tracker.GetRefactorInterval(), 2);
+}
+
+TEST(test_incremental, singular_update) {
+  S21Matrix A(2, 2);
+  A(0, 0) = 1;
+  A(1, 1) = 1;
+  S21IncrementalInverse tracker(A);
+  S21Matrix row(1, 2);
+  row(0, 0) = 1;
+
+  EXPECT_THROW(tracker.ReplaceRow(1, row), std::invalid_argument);
+  EXPECT_TRUE(tracker.GetMatrix() == A);
+  EXPECT_DOUBLE_EQ(tracker.GetDeterminant(), 1);
+  EXPECT_THROW(S21IncrementalInverse(S21Matrix(2, 2)), std::invalid_argument);
+  EXPECT_THROW(tracker.ReplaceCol(0, row), std::invalid_argument);
+
+  // The rank-one update rounds to just above the 1e-6 threshold, the
+  // refactorization it triggers finds the determinant just below.
+  S21Matrix one(1, 1), tiny(1, 1);
+  one(0, 0) = 1;
+  tiny(0, 0) = 9.999999999999997e-07;
+  S21IncrementalInverse refactoring(one, 1);
+  EXPECT_THROW(refactoring.ReplaceRow(0, tiny), std::invalid_argument);
+  EXPECT_TRUE(refactoring.GetMatrix() == one);
+  EXPECT_TRUE(refactoring.GetInverse() == one);
+  EXPECT_DOUBLE_EQ(refactoring.GetDeterminant(), 1);
+}
+
+TEST(test_incremental, in_place_updates_keep_copies) {
+  bool copy_on_write = S21Matrix::GetCopyOnWrite();
+  S21Matrix::SetCopyOnWrite(true);
+  S21IncrementalInverse tracker(make_test_matrix(4));
+  S21Matrix matrix = tracker.GetMatrix(), inverse = tracker.GetInverse();
+  S21Matrix u(4, 1), v(4, 1);
+  for (int i = 0; i < 4; i++) {
+    u(i, 0) = i + 1;
+    v(i, 0) = 0.1 * i;
+  }
+  tracker.RankUpdate(u, v);
+  EXPECT_TRUE(matrix == make_test_matrix(4));
+  EXPECT_TRUE(inverse == make_test_matrix(4).InverseMatrix());
+
+  S21Matrix updated = tracker.GetMatrix();
+  for (int i = 0; i < 4; i++) u(i, 0) = -updated(i, 0);
+  v(0, 0) = 1;
+  for (int i = 1; i < 4; i++) v(i, 0) = 0;
+  EXPECT_THROW(tracker.RankUpdate(u, v), std::invalid_argument);
+  EXPECT_TRUE(tracker.GetMatrix() == updated);
+  EXPECT_TRUE(tracker.GetInverse() == updated.InverseMatrix());
+  S21Matrix::SetCopyOnWrite(copy_on_write);
+}
+
+TEST(test_structured, detect_structure) {
+  S21Matrix A(4, 4);
+  for (int i = 0; i < 4; i++) A(i, i) = i + 1;
+  EXPECT_EQ(A.DetectStructure(), S21Structure::kDiagonal);
+  A(0, 3) = 1;
+  EXPECT_EQ(A.DetectStructure(), S21Structure::kUpperTriangular);
+  A(3, 0) = 1;
+  EXPECT_EQ(A.DetectStructure(), S21Structure::kSymmetric);
+  A(3, 0) = 2;
+  EXPECT_EQ(A.DetectStructure(), S21Structure::kGeneral);
+
+  S21Matrix B(6, 6);
+  for (int i = 0; i < 6; i++) {
+    B(i, i) = 4;
+    if (i + 1 < 6) B(i, i + 1) = B(i + 1, i) = -1;
+  }
+  int lower = -1, upper = -1;
+  EXPECT_EQ(B.DetectStructure(&lower, &upper), S21Structure::kBanded);
+  EXPECT_EQ(lower, 1);
+  EXPECT_EQ(upper, 1);
+}
+
+TEST(test_structured, packed_access) {
+  S21StructuredMatrix L(S21Structure::kLowerTriangular, 3);
+  L(2, 0) = 5;
+  EXPECT_EQ(L(2, 0), 5);
+  EXPECT_THROW(L(0, 2) = 1, std::invalid_argument);
+  const S21StructuredMatrix& cref = L;
+  EXPECT_EQ(cref(0, 2), 0);
+
+  S21StructuredMatrix S(S21Structure::kSymmetric, 3);
+  S(0, 2) = 7;
+  EXPECT_EQ(S(2, 0), 7);
+
+  S21Matrix dense(2, 2);
+  dense(0, 1) = 1;
+  EXPECT_THROW(S21StructuredMatrix(dense, S21Structure::kDiagonal),
+               std::invalid_argument);
+}
+
+TEST(test_structured, triangular_mul_and_solve) {
+  S21Matrix U(4, 4), B(4, 2);
+  for (int i = 0; i < 4; i++) {
+    for (int j = i; j < 4; j++) U(i, j) = 1 + i + 2 * j;
+    B(i, 0) = i - 1;
+    B(i, 1) = 2 * i + 1;
+  }
+  S21StructuredMatrix T(U, S21Structure::kUpperTriangular);
+
+  EXPECT_TRUE(T.MulMatrix(B) == U * B);
+  EXPECT_TRUE(U * T.Solve(B) == B);
+  EXPECT_TRUE(T.ToDense() == U);
+  EXPECT_NEAR(T.Determinant(), 1 * 4 * 7 * 10, 1e-12);
+}
+
+TEST(test_structured, banded_determinant_inverse) {
+  const int n = 7;
+  S21Matrix A(n, n);
+  for (int i = 0; i < n; i++) {
+    A(i, i) = 0.5 + i % 3;
+    if (i + 1 < n) A(i, i + 1) = 2;
+    if (i >= 1) A(i, i - 1) = 3 - i % 2;
+    if (i >= 2) A(i, i - 2) = 1;
+  }
+  S21StructuredMatrix band(A, S21Structure::kBanded, 2, 1);
+  S21Matrix I(n, n);
+  for (int i = 0; i < n; i++) I(i, i) = 1;
+
+  S21Matrix inverse = band.InverseMatrix();
+  EXPECT_TRUE(A * inverse == I);
+  EXPECT_TRUE(band.MulMatrix(inverse) == I);
+  double expected = S21IncrementalInverse(A).GetDeterminant();
+  EXPECT_NEAR(band.Determinant(), expected, 1e-9 * std::fabs(expected));
+
+  S21Matrix inverted;
+  EXPECT_EQ(band.Invert(&inverted), band.Determinant());
+  EXPECT_TRUE(inverted == inverse);
+  S21StructuredMatrix symmetric(A + A.Transpose(), S21Structure::kSymmetric);
+  EXPECT_NE(symmetric.Invert(&inverted), 0);
+  EXPECT_TRUE(symmetric.MulMatrix(inverted) == I);
+
+  for (int j = 1; j < 5; j++) band(3, j) = 0;
+  S21Matrix untouched(2, 2);
+  EXPECT_EQ(band.Invert(&untouched), 0);
+  EXPECT_EQ(untouched.GetRows(), 2);
+  EXPECT_THROW(band.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(test_structured, automatic_dispatch) {
+  S21Matrix D(5, 5);
+  for (int i = 0; i < 5; i++) D(i, i) = i + 2;
+  EXPECT_DOUBLE_EQ(D.Determinant(), 2 * 3 * 4 * 5 * 6);
+  S21Matrix inverse = D.InverseMatrix();
+  EXPECT_DOUBLE_EQ(inverse(3, 3), 0.2);
+  EXPECT_EQ(inverse(3, 2), 0);
+
+  D(4, 4) = 0;
+  EXPECT_THROW(D.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(test_task_graph, pipeline) {
+  S21Matrix A = make_test_matrix(4), B = make_test_matrix(4) * 0.5;
+  S21TaskGraph graph;
+  auto a = graph.Input(A);
+  auto b = graph.Input(B);
+  auto product = graph.Mul(a, b);
+  auto sum = graph.Sum(product, graph.Transpose(a), 1);
+  auto inverse = graph.Inverse(sum);
+  auto det = graph.Determinant(b);
+  auto custom = graph.Apply({inverse, sum}, [](const auto& in) {
+    return *in[0] * *in[1];
+  });
+
+  S21Matrix expected = A * B + A.Transpose();
+  EXPECT_TRUE(sum.Get() == expected);
+  EXPECT_TRUE(inverse.Get() == expected.InverseMatrix());
+  EXPECT_NEAR(det.GetScalar(), B.Determinant(), 1e-9);
+  EXPECT_TRUE(custom.Get() == expected.InverseMatrix() * expected);
+  EXPECT_TRUE(custom.IsReady());
+}
+
+TEST(test_task_graph, releases_consumed_results) {
+  S21ThreadPool pool(1);
+  S21TaskGraph graph(pool);
+  auto sentinel = std::make_shared<int>(0);
+  std::weak_ptr<int> watch = sentinel;
+  S21TaskGraph::Handle result;
+  {
+    auto input = graph.Input(make_test_matrix(3));
+    auto middle = graph.Apply({input}, [sentinel](const auto& in) {
+      return *in[0] * 2;
+    });
+    result = graph.Transpose(middle);
+  }
+  sentinel.reset();
+  EXPECT_TRUE(result.Get() == (make_test_matrix(3) * 2).Transpose());
+  EXPECT_TRUE(watch.expired());
+}
+
+TEST(test_task_graph, failure_propagates) {
+  S21TaskGraph graph;
+  auto bad = graph.Mul(graph.Input(S21Matrix(2, 3)),
+                       graph.Input(S21Matrix(2, 3)));
+  auto dependent = graph.MulNumber(bad, 2);
+  EXPECT_THROW(bad.Get(), std::invalid_argument);
+  EXPECT_THROW(dependent.Get(), std::invalid_argument);
+  EXPECT_THROW(graph.Transpose(S21TaskGraph::Handle()),
+               std::invalid_argument);
+}
+
+TEST(test_task_graph, cancel_and_priority) {
+  S21ThreadPool pool(1);
+  S21TaskGraph graph(pool);
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  auto input = graph.Input(S21Matrix(2, 2));
+  auto blocker = graph.Apply({input}, [opened](const auto& in) {
+    opened.wait();
+    return *in[0];
+  });
+  std::vector<int> order;
+  auto low = graph.Apply(
+      {input}, [&order](const auto& in) {
+        order.push_back(0);
+        return *in[0];
+      },
+      0);
+  auto high = graph.Apply(
+      {input}, [&order](const auto& in) {
+        order.push_back(1);
+        return *in[0];
+      },
+      5);
+  auto dropped = graph.MulNumber(input, 3);
+  auto after_dropped = graph.Transpose(dropped);
+
+  EXPECT_TRUE(dropped.Cancel());
+  gate.set_value();
+  graph.WaitAll();
+
+  EXPECT_FALSE(blocker.Cancel());
+  EXPECT_THROW(dropped.Get(), std::runtime_error);
+  EXPECT_THROW(after_dropped.Get(), std::runtime_error);
+  ASSERT_EQ(order.size(), 2u);
+  EXPECT_EQ(order[0], 1);
+  EXPECT_EQ(order[1], 0);
+  EXPECT_TRUE(low.Get() == S21Matrix(2, 2));
+  EXPECT_TRUE(high.Get() == S21Matrix(2, 2));
+}
+
+TEST(test_numa, policies_allocate_zeroed_storage) {
+  const S21NumaPolicy policies[] = {
+      S21NumaPolicy::kInterleave, S21NumaPolicy::kParallelFirstTouch,
+      S21NumaPolicy::kNodeLocalTiles, S21NumaPolicy::kDefault};
+  S21Numa::SetMinBytes(0);
+  S21Numa::SetThreadPinning(true);
+  for (S21NumaPolicy policy : policies) {
+    S21Numa::SetPolicy(policy);
+    EXPECT_EQ(S21Numa::GetPolicy(), policy);
+    S21Matrix m(67, 129);
+    for (int i = 0; i < 67; i++)
+      for (int j = 0; j < 129; j++) EXPECT_EQ(m(i, j), 0);
+    m(66, 128) = 5;
+    S21Matrix copy = m.Transpose().Transpose();
+    EXPECT_TRUE(copy == m);
+    EXPECT_EQ(&m(1, 0) - &m(0, 0), 129);
+  }
+  S21Numa::SetThreadPinning(false);
+  S21Numa::SetMinBytes(std::size_t(1) << 22);
+  EXPECT_FALSE(S21Numa::GetThreadPinning());
+  EXPECT_GE(S21Numa::NodeCount(), 1);
+}
+
+TEST(test_uninitialized, tagged_constructor) {
+  S21Matrix m(3, 4, kS21Uninitialized);
+  EXPECT_EQ(m.GetRows(), 3);
+  EXPECT_EQ(m.GetCols(), 4);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 4; j++) m(i, j) = i * 4 + j;
+  EXPECT_EQ(m(2, 3), 11);
+  EXPECT_ANY_THROW(S21Matrix(0, 4, kS21Uninitialized));
+}
+
+TEST(test_uninitialized, resize_zero_fills_new_cells) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 1;
+  m(1, 1) = 2;
+  m.SetRows(4);
+  m.SetCols(3);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_EQ(m(i, j), (i == j && i < 2) ? i + 1 : 0);
+
+  m.SetCols(1);
+  m.SetRows(1);
+  EXPECT_EQ(m(0, 0), 1);
+}
+
+TEST(test_capacity, append_rows_grows_geometrically) {
+  S21Matrix m(1, 3);
+  S21Matrix row(1, 3);
+  int reallocations = 0;
+  for (int i = 1; i < 1000; i++) {
+    for (int j = 0; j < 3; j++) row(0, j) = i * 3 + j;
+    int capacity = m.GetRowCapacity();
+    m.AppendRow(row);
+    if (m.GetRowCapacity() != capacity) reallocations++;
+  }
+  EXPECT_EQ(m.GetRows(), 1000);
+  EXPECT_GE(m.GetRowCapacity(), 1000);
+  EXPECT_LE(reallocations, 10);
+  for (int i = 1; i < 1000; i++) EXPECT_EQ(m(i, 2), i * 3 + 2);
+  EXPECT_ANY_THROW(m.AppendRow(S21Matrix(1, 2)));
+}
+
+TEST(test_capacity, append_cols_and_shrink) {
+  S21Matrix m(2, 1);
+  m(1, 0) = 7;
+  S21Matrix col(2, 1);
+  for (int j = 1; j < 20; j++) {
+    col(0, 0) = j;
+    col(1, 0) = -j;
+    m.AppendCol(col);
+  }
+  EXPECT_EQ(m.GetCols(), 20);
+  EXPECT_GE(m.GetColCapacity(), 20);
+  EXPECT_EQ(m(1, 0), 7);
+  EXPECT_EQ(m(1, 19), -19);
+
+  m.ShrinkToFit();
+  EXPECT_EQ(m.GetColCapacity(), 20);
+  EXPECT_EQ(m.GetRowCapacity(), 2);
+  S21Matrix copy(m);
+  EXPECT_TRUE(copy == m);
+}
+
+TEST(test_capacity, reserve_and_resize_in_place) {
+  S21Matrix m(2, 2);
+  m.Reserve(8, 6);
+  EXPECT_EQ(m.GetRowCapacity(), 8);
+  EXPECT_EQ(m.GetColCapacity(), 6);
+  const double* storage = &m(0, 0);
+
+  m.SetRows(8);
+  m.SetCols(6);
+  m(7, 5) = 3;
+  m.SetRows(2);
+  m.SetCols(2);
+  m.SetRows(8);
+  m.SetCols(6);
+
+  EXPECT_EQ(&m(0, 0), storage);
+  EXPECT_EQ(m(7, 5), 0);
+  S21Matrix t = m.Transpose();
+  EXPECT_EQ(t.GetRows(), 6);
+  EXPECT_EQ(t.GetRowCapacity(), 6);
+}
+
+TEST(test_compare, approx_equal_tolerances) {
+  S21Matrix a(3, 40), b(3, 40);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 40; j++) a(i, j) = b(i, j) = 1e6 * (i + 1) + j;
+  b(2, 39) += 0.01;
+
+  EXPECT_FALSE(a.ApproxEqual(b));
+  S21Tolerance relative;
+  relative.relative = 1e-8;
+  EXPECT_TRUE(a.ApproxEqual(b, relative));
+  EXPECT_FALSE(a.ApproxEqual(S21Matrix(3, 39)));
+
+  S21Matrix c(1, 1), d(1, 1);
+  c(0, 0) = 1.0;
+  d(0, 0) = std::nextafter(std::nextafter(1.0, 2.0), 2.0);
+  S21Tolerance ulps;
+  ulps.absolute = 0;
+  ulps.ulps = 2;
+  EXPECT_TRUE(c.ApproxEqual(d, ulps));
+  ulps.ulps = 1;
+  EXPECT_FALSE(c.ApproxEqual(d, ulps));
+  d(0, 0) = NAN;
+  EXPECT_FALSE(c.ApproxEqual(d));
+}
+
+TEST(test_compare, fingerprint_and_exact_equal) {
+  S21Matrix a(4, 5), b(4, 5);
+  a(1, 2) = 3.5;
+  b(1, 2) = 3.5;
+  b(3, 4) = -0.0;
+
+  EXPECT_EQ(a.Fingerprint(), b.Fingerprint());
+  EXPECT_TRUE(a.ExactEqual(b));
+  S21Matrix copy(a);
+  EXPECT_EQ(copy.Fingerprint(), a.Fingerprint());
+
+  b(0, 0) = 1;
+  EXPECT_NE(a.Fingerprint(), b.Fingerprint());
+  EXPECT_FALSE(a.ExactEqual(b));
+  b.MulNumber(0);
+  EXPECT_NE(a.Fingerprint(), b.Fingerprint());
+  b(1, 2) = 3.5;
+  EXPECT_EQ(a.Fingerprint(), b.Fingerprint());
+  EXPECT_NE(S21Matrix(2, 10).Fingerprint(), S21Matrix(10, 2).Fingerprint());
+}
+
+TEST(test_result_cache, hits_and_invalidation) {
+  S21ResultCache cache;
+  S21Matrix A = make_test_matrix(4);
+
+  S21Matrix first = cache.InverseMatrix(A);
+  S21Matrix second = cache.InverseMatrix(A);
+  EXPECT_TRUE(first == A.InverseMatrix());
+  EXPECT_TRUE(second.ExactEqual(first));
+  EXPECT_NEAR(cache.Determinant(A), A.Determinant(), 1e-9);
+  EXPECT_TRUE(cache.CalcComplements(A) == A.CalcComplements());
+
+  S21ResultCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.entries, 3u);
+
+  A(0, 0) += 1;
+  EXPECT_TRUE(cache.InverseMatrix(A) == A.InverseMatrix());
+  EXPECT_EQ(cache.GetStats().misses, 4u);
+  EXPECT_THROW(cache.InverseMatrix(S21Matrix(2, 2)), std::invalid_argument);
+}
+
+TEST(test_result_cache, lru_budget) {
+  S21Matrix A = make_test_matrix(3), B = make_test_matrix(3) * 2;
+  S21ResultCache cache(1);
+  cache.InverseMatrix(A);
+  EXPECT_EQ(cache.GetStats().entries, 0u);
+
+  cache.SetBudget(1 << 20);
+  cache.InverseMatrix(A);
+  cache.InverseMatrix(B);
+  cache.InverseMatrix(A);
+  std::size_t one_entry = cache.GetStats().bytes / 2;
+  cache.SetBudget(one_entry);
+  S21ResultCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.entries, 1u);
+  EXPECT_EQ(stats.evictions, 1u);
+  cache.InverseMatrix(A);
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+  cache.Clear();
+  EXPECT_EQ(cache.GetStats().bytes, 0u);
+}
+
+TEST(test_result_cache, concurrent_lookups) {
+  S21ResultCache cache;
+  S21Matrix A = make_test_matrix(5), B = make_test_matrix(5) * 3;
+  S21Matrix expected_a = A.InverseMatrix(), expected_b = B.InverseMatrix();
+  std::vector<std::thread> threads;
+  std::atomic<int> mismatches{0};
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 50; i++) {
+        const S21Matrix& input = (i + t) % 2 ? A : B;
+        const S21Matrix& expected = (i + t) % 2 ? expected_a : expected_b;
+        if (!(cache.InverseMatrix(input) == expected)) mismatches++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(mismatches, 0);
+  S21ResultCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits + stats.misses, 200u);
+  EXPECT_EQ(stats.entries, 2u);
+}
+
+TEST(test_result_cache, lookups_survive_eviction) {
+  S21ResultCache cache;
+  S21Matrix A = make_test_matrix(6);
+  S21Matrix expected = A.InverseMatrix();
+  std::atomic<int> mismatches{0};
+  std::atomic<bool> done{false};
+  std::thread evictor([&] {
+    while (!done) {
+      cache.Clear();
+      cache.SetBudget(std::size_t(64) << 20);
+    }
+  });
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; t++) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 200; i++) {
+        if (!(cache.InverseMatrix(A) == expected)) mismatches++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  done = true;
+  evictor.join();
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_EQ(cache.GetStats().hits + cache.GetStats().misses, 600u);
+}
+
+class test_cow : public ::testing::Test {
+ protected:
+  void SetUp() override { S21Matrix::SetCopyOnWrite(true); }
+  void TearDown() override { S21Matrix::SetCopyOnWrite(false); }
+};
+
+TEST_F(test_cow, copies_share_until_written) {
+  S21Matrix a = make_test_matrix(3);
+  S21Matrix b(a);
+  S21Matrix c;
+  c = a;
+  EXPECT_EQ(&static_cast<const S21Matrix&>(b)(0, 0),
+            &static_cast<const S21Matrix&>(a)(0, 0));
+
+  b(0, 0) = 100;
+  c.MulNumber(2);
+  EXPECT_TRUE(a == make_test_matrix(3));
+  EXPECT_EQ(b(0, 0), 100);
+  EXPECT_TRUE(c == make_test_matrix(3) * 2);
+
+  S21Matrix d(a);
+  d.SetRows(5);
+  d.AppendCol(S21Matrix(5, 1));
+  EXPECT_EQ(a.GetRows(), 3);
+  EXPECT_TRUE(a == make_test_matrix(3));
+}
+
+TEST_F(test_cow, internal_writers_detach) {
+  S21Matrix a = make_test_matrix(4);
+  S21Matrix sym = a + a.Transpose();
+  S21Matrix sym_copy(sym);
+  S21Matrix vectors;
+  sym.SymmetricEigen(&vectors);
+  sym.SVD();
+  EXPECT_TRUE(sym.ExactEqual(sym_copy));
+
+  S21IncrementalInverse tracker(a);
+  S21Matrix inverse = tracker.GetInverse();
+  S21Matrix row(1, 4);
+  row(0, 1) = 3;
+  tracker.ReplaceRow(0, row);
+  EXPECT_TRUE(inverse == a.InverseMatrix());
+  EXPECT_TRUE(a == make_test_matrix(4));
+
+  S21StructuredMatrix diag(S21Structure::kDiagonal, 4);
+  for (int i = 0; i < 4; i++) diag(i, i) = 2;
+  S21Matrix rhs(a);
+  diag.Solve(rhs);
+  EXPECT_TRUE(rhs == make_test_matrix(4));
+}
+
+TEST_F(test_cow, concurrent_copies_and_writes) {
+  const S21Matrix source = make_test_matrix(16);
+  std::vector<std::thread> threads;
+  std::atomic<int> errors{0};
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 200; i++) {
+        S21Matrix copy(source);
+        S21Matrix second = copy;
+        copy(i % 16, t) += 1;
+        if (second(i % 16, t) != source(i % 16, t)) errors++;
+        if (copy(i % 16, t) != source(i % 16, t) + 1) errors++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(errors, 0);
+  EXPECT_TRUE(source == make_test_matrix(16));
+}
+
+TEST(test_power, matches_repeated_products) {
+  S21Matrix a = make_test_matrix(5) * 0.2;
+  S21Matrix expected(a);
+  for (int k = 2; k <= 11; k++) {
+    expected *= a;
+    EXPECT_TRUE(a.Power(k).ApproxEqual(expected, {1e-09, 1e-09}));
+  }
+  S21Matrix identity = a.Power(0);
+  for (int i = 0; i < 5; i++) EXPECT_EQ(identity(i, i), 1);
+  EXPECT_TRUE(a.Power(1) == a);
+}
+
+TEST(test_power, negative_and_errors) {
+  S21Matrix a = make_test_matrix(4);
+  S21Matrix inverse = a.InverseMatrix();
+  EXPECT_TRUE(a.Power(-3) == inverse * inverse * inverse);
+  EXPECT_TRUE((a.Power(-2) * a.Power(2)).EqMatrix(a.Power(0)));
+  EXPECT_THROW(S21Matrix(2, 3).Power(2), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(3, 3).Power(-1), std::invalid_argument);
+}
+
+TEST(test_power, negative_large_order) {
+  S21Matrix a = make_test_matrix(40);
+  EXPECT_TRUE((a.Power(-2) * a.Power(2)).EqMatrix(a.Power(0)));
+  S21Matrix b = make_test_matrix(12);
+  double det_b = b.Determinant();
+  EXPECT_NEAR((b * b).Determinant(), det_b * det_b, 1e-9 * det_b * det_b);
+  // Symmetric but indefinite: Cholesky fails and LU takes over, while
+  // its square is positive definite and goes through Cholesky.
+  S21Matrix s = b + b.Transpose();
+  s(0, 0) = -100;
+  double det_s = s.Determinant();
+  EXPECT_LT(det_s, 0);
+  EXPECT_NEAR((s * s).Determinant(), det_s * det_s, 1e-9 * det_s * det_s);
+}
+
+TEST(test_exp, closed_forms) {
+  S21Matrix diag(3, 3);
+  diag(0, 0) = -1;
+  diag(1, 1) = 0.001;
+  diag(2, 2) = 4;
+  S21Matrix e = diag.Exp();
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(e(i, i), std::exp(diag(i, i)), 1e-12 * std::exp(diag(i, i)));
+  }
+  EXPECT_EQ(e(0, 1), 0);
+
+  S21Matrix nilpotent(2, 2);
+  nilpotent(0, 1) = 1;
+  S21Matrix shear = nilpotent.Exp();
+  EXPECT_DOUBLE_EQ(shear(0, 0), 1);
+  EXPECT_DOUBLE_EQ(shear(0, 1), 1);
+  EXPECT_DOUBLE_EQ(shear(1, 0), 0);
+
+  // A large rotation generator goes through scaling and squaring.
+  double angle = 30;
+  S21Matrix generator(2, 2);
+  generator(0, 1) = -angle;
+  generator(1, 0) = angle;
+  S21Matrix rotation = generator.Exp();
+  EXPECT_NEAR(rotation(0, 0), std::cos(angle), 1e-12);
+  EXPECT_NEAR(rotation(1, 0), std::sin(angle), 1e-12);
+  EXPECT_THROW(S21Matrix(2, 3).Exp(), std::invalid_argument);
+}
+
+TEST(test_exp, inverse_of_negation) {
+  S21Matrix a = make_test_matrix(6) * 0.5;
+  S21Matrix product = a.Exp() * (a * -1).Exp();
+  EXPECT_TRUE(product.ApproxEqual(a.Power(0), {1e-09}));
+}
+
+TEST(test_reduce, sums_and_norms) {
+  S21Matrix a(2, 3);
+  double values[] = {1, -2, 3, -4, 5, -6};
+  for (int i = 0; i < 6; i++) a(i / 3, i % 3) = values[i];
+  EXPECT_DOUBLE_EQ(a.Sum(), -3);
+  EXPECT_DOUBLE_EQ(a.MaxAbs(), 6);
+  EXPECT_DOUBLE_EQ(a.FrobeniusNorm(), std::sqrt(91.0));
+  EXPECT_DOUBLE_EQ(a.OneNorm(), 9);
+  EXPECT_DOUBLE_EQ(a.InfNorm(), 15);
+  EXPECT_DOUBLE_EQ(a.Dot(a), 91);
+  S21Matrix rows = a.RowSums();
+  S21Matrix cols = a.ColSums();
+  EXPECT_EQ(rows.GetRows(), 2);
+  EXPECT_DOUBLE_EQ(rows(1, 0), -5);
+  EXPECT_EQ(cols.GetCols(), 3);
+  EXPECT_DOUBLE_EQ(cols(0, 2), -3);
+  EXPECT_DOUBLE_EQ(make_test_matrix(4).Trace(),
+                   16 + std::sin(1) + std::sin(11) + std::sin(21) +
+                       std::sin(31));
+  EXPECT_THROW(a.Trace(), std::invalid_argument);
+  EXPECT_THROW(a.Dot(S21Matrix(3, 2)), std::invalid_argument);
+}
+
+TEST(test_reduce, accuracy_and_scaling) {
+  // A running sum of 2^20 copies of 0.1 is off by about 1.6e-6.
+  S21Matrix tenths(1024, 1024);
+  for (int i = 0; i < 1024; i++)
+    for (int j = 0; j < 1024; j++) tenths(i, j) = 0.1;
+  EXPECT_NEAR(tenths.Sum(), 0.1 * (1 << 20), 1e-09);
+  EXPECT_NEAR(tenths.Dot(tenths), 0.01 * (1 << 20), 1e-09);
+
+  // Compensated column sums keep every 1.0 added to 1e16.
+  S21Matrix column(4001, 1);
+  column(0, 0) = 1e16;
+  for (int i = 1; i < 4001; i++) column(i, 0) = 1;
+  EXPECT_EQ(column.ColSums()(0, 0), 1e16 + 4000);
+
+  S21Matrix huge(2, 2);
+  huge(0, 0) = 3e200;
+  huge(1, 1) = 4e200;
+  EXPECT_NEAR(huge.FrobeniusNorm() / 5e200, 1, 1e-15);
+  S21Matrix tiny = huge * 1e-200 * 1e-200;
+  EXPECT_NEAR(tiny.FrobeniusNorm() / 5e-200, 1, 1e-15);
+  EXPECT_EQ(S21Matrix(3, 3).FrobeniusNorm(), 0);
+}
+
+TEST(test_reduce, two_norm_estimate) {
+  S21Matrix diag(3, 3);
+  diag(0, 0) = 2;
+  diag(1, 1) = -7;
+  diag(2, 2) = 3;
+  EXPECT_NEAR(diag.TwoNormEstimate(), 7, 1e-05);
+
+  S21Matrix sign_pattern(2, 2);
+  sign_pattern(0, 0) = sign_pattern(1, 0) = 1;
+  sign_pattern(0, 1) = sign_pattern(1, 1) = -1;
+  EXPECT_NEAR(sign_pattern.TwoNormEstimate(), 2, 1e-05);
+
+  S21Matrix a = make_test_matrix(6);
+  S21Matrix singular = a.SVD();
+  EXPECT_NEAR(a.TwoNormEstimate(100, 1e-12), singular(0, 0), 1e-06);
+  EXPECT_LE(a.TwoNormEstimate(), a.FrobeniusNorm());
+  EXPECT_EQ(S21Matrix(2, 2).TwoNormEstimate(), 0);
+}
+
+TEST(test_vector, conversions_and_access) {
+  S21Matrix column(3, 1);
+  column(2, 0) = 5;
+  S21Vector v(column);
+  EXPECT_EQ(v.GetSize(), 3);
+  EXPECT_EQ(v(2), 5);
+  EXPECT_TRUE(v.ToColumn() == column);
+  EXPECT_TRUE(S21Vector(v.ToRow()) == v);
+  v(0) = 2;
+  EXPECT_EQ(v.Dot(v), 29);
+  EXPECT_THROW(v(3), std::invalid_argument);
+  EXPECT_THROW(S21Vector(S21Matrix(2, 2)), std::invalid_argument);
+  EXPECT_THROW(v.Dot(S21Vector(2)), std::invalid_argument);
+}
+
+TEST(test_vector, equality_matches_eq_matrix) {
+  S21Matrix a(2, 1), b(2, 1);
+  b(1, 0) = 1e-07;
+  EXPECT_FALSE(a.EqMatrix(b));
+  EXPECT_FALSE(S21Vector(a) == S21Vector(b));
+  b(1, 0) = 0.99e-07;
+  EXPECT_TRUE(a.EqMatrix(b));
+  EXPECT_TRUE(S21Vector(a) == S21Vector(b));
+}
+
+TEST(test_vector, gemv_and_ger) {
+  S21Matrix a(make_test_matrix(7));
+  a.SetCols(5);
+  S21Vector x(5), t(7);
+  for (int i = 0; i < 5; i++) x(i) = i - 2.5;
+  for (int i = 0; i < 7; i++) t(i) = std::cos(i);
+
+  S21Vector y = a * x;
+  EXPECT_TRUE(y.ToColumn() == a * x.ToColumn());
+  S21Vector z(t);
+  S21Vector::Gemv(false, 2, a, x, -1, &z);
+  EXPECT_TRUE(z.ToColumn() == a * x.ToColumn() * 2 - t.ToColumn());
+  S21Vector::Gemv(true, 1, a, t, 0, &z);
+  EXPECT_EQ(z.GetSize(), 5);
+  EXPECT_TRUE(z.ToRow() == t.ToRow() * a);
+  EXPECT_THROW(S21Vector::Gemv(true, 1, a, x, 0, &z), std::invalid_argument);
+
+  S21Matrix updated(a);
+  S21Vector::Ger(3, t, x, &updated);
+  EXPECT_TRUE(updated == a + t.ToColumn() * x.ToRow() * 3);
+  EXPECT_THROW(S21Vector::Ger(1, x, t, &updated), std::invalid_argument);
+}
+
+TEST(test_vector, matrix_vector_products_through_mul_matrix) {
+  S21Matrix a = make_test_matrix(6);
+  S21Matrix column(6, 1), row(1, 6);
+  for (int i = 0; i < 6; i++) {
+    column(i, 0) = i + 1;
+    row(0, i) = 1 - i;
+  }
+  S21Matrix expected_column(6, 1), expected_row(1, 6);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      expected_column(i, 0) += a(i, j) * column(j, 0);
+      expected_row(0, j) += row(0, i) * a(i, j);
+    }
+  }
+  EXPECT_TRUE(a * column == expected_column);
+  EXPECT_TRUE(row * a == expected_row);
+}
+
+TEST(test_gemm, all_transpositions) {
+  S21Matrix a = make_test_matrix(5);
+  a.SetCols(3);
+  S21Matrix b = make_test_matrix(4) * -0.5;
+  b.SetRows(3);
+  S21Matrix c0 = make_test_matrix(5);
+  c0.SetCols(4);
+  for (int flags = 0; flags < 4; flags++) {
+    bool trans_a = flags & 1, trans_b = flags & 2;
+    S21Matrix left = trans_a ? a.Transpose() : a;
+    S21Matrix right = trans_b ? b.Transpose() : b;
+    S21Matrix c(c0);
+    S21Matrix::Gemm(trans_a, trans_b, 2, left, right, -3, &c);
+    EXPECT_TRUE(c == a * b * 2 - c0 * 3);
+  }
+}
+
+TEST(test_gemm, beta_zero_resizes_and_aliasing) {
+  S21Matrix a = make_test_matrix(4);
+  S21Matrix c;
+  S21Matrix::Gemm(true, false, 1, a, a, 0, &c);
+  EXPECT_TRUE(c == a.Transpose() * a);
+
+  S21Matrix alias(a);
+  S21Matrix::Gemm(false, true, 1, alias, alias, 1, &alias);
+  EXPECT_TRUE(alias == a * a.Transpose() + a);
+
+  S21Matrix wrong(3, 3);
+  EXPECT_THROW(S21Matrix::Gemm(false, false, 1, a, a, 1, &wrong),
+               std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Gemm(false, false, 1, a, S21Matrix(3, 4), 0, &c),
+               std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Gemm(false, false, 1, a, a, 0, nullptr),
+               std::invalid_argument);
+}
+
+class test_accumulation : public ::testing::Test {
+ protected:
+  void TearDown() override {
+    S21Matrix::SetAccumulation(S21Accumulation::kFast);
+  }
+};
+
+TEST_F(test_accumulation, cancelling_sums) {
+  // 1e16 + 1 - 1e16 loses the 1 with plain summation.
+  S21Matrix row(1, 3), column(3, 1);
+  row(0, 0) = 1e16;
+  row(0, 1) = 1;
+  row(0, 2) = -1e16;
+  for (int i = 0; i < 3; i++) column(i, 0) = 1;
+  EXPECT_EQ((row * column)(0, 0), 0);
+  S21Matrix::SetAccumulation(S21Accumulation::kCompensated);
+  EXPECT_EQ((row * column)(0, 0), 1);
+  S21Matrix c;
+  S21Matrix::Gemm(true, true, 1, column, row, 0, &c);
+  EXPECT_EQ(c(0, 0), 1);
+  S21Matrix::SetAccumulation(S21Accumulation::kTwoSum);
+  EXPECT_EQ((row * column)(0, 0), 1);
+}
+
+TEST_F(test_accumulation, product_rounding_errors) {
+  // (1 + 2^-30)^2 - (1 + 2^-29) = 2^-60 needs the exact product.
+  double x = 1 + std::ldexp(1.0, -30);
+  S21Matrix row(1, 2), column(2, 1);
+  row(0, 0) = x;
+  row(0, 1) = -(1 + std::ldexp(1.0, -29));
+  column(0, 0) = x;
+  column(1, 0) = 1;
+  S21Matrix::SetAccumulation(S21Accumulation::kCompensated);
+  EXPECT_EQ((row * column)(0, 0), 0);
+  S21Matrix::SetAccumulation(S21Accumulation::kTwoSum);
+  EXPECT_EQ((row * column)(0, 0), std::ldexp(1.0, -60));
+  S21Matrix c;
+  S21Matrix::Gemm(false, true, 4, row, column.Transpose(), 0, &c);
+  EXPECT_EQ(c(0, 0), std::ldexp(1.0, -58));
+}
+
+TEST_F(test_accumulation, policies_agree_on_ordinary_input) {
+  S21Matrix a = make_test_matrix(37);
+  S21Matrix b = make_test_matrix(37).Transpose() * 0.5;
+  S21Matrix fast = a * b;
+  for (S21Accumulation mode :
+       {S21Accumulation::kCompensated, S21Accumulation::kTwoSum}) {
+    S21Matrix::SetAccumulation(mode);
+    EXPECT_TRUE((a * b).ApproxEqual(fast, {1e-12, 1e-13}));
+    S21Matrix c(b);
+    S21Matrix::Gemm(true, false, 2, a, b, 1, &c);
+    EXPECT_TRUE(c.ApproxEqual(a.Transpose() * b * 2 + b, {1e-12, 1e-13}));
+  }
+}
+
+// Differential tests: every optimized path against the frozen reference
+// algorithms in s21_reference.h on random shapes and values.
+using s21_reference::Dense;
+
+static double RandomValue(std::mt19937& rng, bool special) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double specials[] = {0.0,   -0.0,   1e-310, -1e-310, 1e150,
+                             -1e150, 1e300, inf,    -inf,    NAN};
+  if (special && rng() % 8 == 0) return specials[rng() % 10];
+  std::uniform_real_distribution<double> unit(-1, 1);
+  return unit(rng) * std::pow(10.0, static_cast<int>(rng() % 7) - 3);
+}
+
+static Dense RandomDense(std::mt19937& rng, int rows, int cols,
+                         bool special = false) {
+  Dense result(rows, cols);
+  for (double& value : result.values) value = RandomValue(rng, special);
+  return result;
+}
+
+// Square test matrices of several structures and conditionings: dense,
+// diagonal, upper and lower triangular, tridiagonal, symmetric positive
+// definite, badly scaled, singular, banded with pivoting (kind 8) and
+// symmetric indefinite (kind 9).
+static Dense RandomSquare(std::mt19937& rng, int n, int kind) {
+  Dense a = RandomDense(rng, n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      bool keep = kind == 0 || kind == 6 || kind == 7 ||
+                  (kind == 1 && i == j) || (kind == 2 && j >= i) ||
+                  (kind == 3 && j <= i) ||
+                  (kind == 4 && std::abs(i - j) <= 1) ||
+                  (kind == 8 && i - j <= 2 && j - i <= 1);
+      if (kind == 5 || kind == 9) a(i, j) = a(std::max(i, j), std::min(i, j));
+      if (!keep && kind != 5 && kind != 9) a(i, j) = 0;
+    }
+    if (kind <= 5) a(i, i) += n;
+    if (kind == 9) a(i, i) += i % 2 == 0 ? n : -n;
+    if (kind == 6) {
+      for (int j = 0; j < n; j++) a(i, j) *= std::pow(10.0, 2 * i - n);
+    }
+  }
+  if (kind == 7 && n > 1) {
+    for (int j = 0; j < n; j++) a(n - 1, j) = a(0, j);
+  }
+  return a;
+}
+
+// Product of the row norms: bounds |det| and scales its rounding error.
+static double HadamardBound(const Dense& a) {
+  double bound = 1;
+  for (int i = 0; i < a.rows; i++) {
+    double norm = 0;
+    for (int j = 0; j < a.cols; j++) norm += a(i, j) * a(i, j);
+    bound *= std::sqrt(norm);
+  }
+  return bound;
+}
+
+TEST(test_differential, products_match_reference) {
+  std::mt19937 rng(2024);
+  const double eps = std::numeric_limits<double>::epsilon();
+  const S21Accumulation modes[] = {S21Accumulation::kFast,
+                                   S21Accumulation::kCompensated,
+                                   S21Accumulation::kTwoSum};
+  for (int iteration = 0; iteration < 150; iteration++) {
+    int m = 1 + rng() % 33, k = 1 + rng() % 33, n = 1 + rng() % 33;
+    if (iteration % 5 == 0) n = 1;
+    if (iteration % 7 == 0) m = 1;
+    bool special = iteration % 4 == 0;
+    Dense a = RandomDense(rng, m, k, special);
+    Dense b = RandomDense(rng, k, n, special);
+    Dense expected = s21_reference::Mul(a, b);
+    Dense scale = s21_reference::AbsMul(a, b);
+    S21Matrix left = a.ToMatrix(), right = b.ToMatrix();
+    for (S21Accumulation mode : modes) {
+      S21Matrix::SetAccumulation(mode);
+      EXPECT_TRUE(s21_reference::Matches(left * right, expected, scale,
+                                         2 * k * eps))
+          << m << "x" << k << "x" << n << " mode " << static_cast<int>(mode);
+    }
+    S21Matrix::SetAccumulation(S21Accumulation::kFast);
+    if (n == 1) {
+      S21Vector y = left * S21Vector(right);
+      EXPECT_TRUE(s21_reference::Matches(y.ToColumn(), expected, scale,
+                                         2 * k * eps));
+    }
+    if (special) continue;
+
+    // Gemm with every transposition reads the transposed copies in place.
+    Dense c0 = RandomDense(rng, m, n);
+    double alpha = RandomValue(rng, false), beta = RandomValue(rng, false);
+    Dense gemm_expected = s21_reference::Sum(
+        s21_reference::MulNumber(expected, alpha),
+        s21_reference::MulNumber(c0, beta));
+    Dense gemm_scale = s21_reference::MulNumber(scale, std::fabs(alpha));
+    for (int i = 0; i < m * n; i++) {
+      gemm_scale.values[i] += std::fabs(beta * c0.values[i]);
+    }
+    for (int flags = 0; flags < 4; flags++) {
+      bool trans_a = flags & 1, trans_b = flags & 2;
+      S21Matrix op_a = trans_a ? s21_reference::Transpose(a).ToMatrix() : left;
+      S21Matrix op_b =
+          trans_b ? s21_reference::Transpose(b).ToMatrix() : right;
+      S21Matrix c = c0.ToMatrix();
+      S21Matrix::Gemm(trans_a, trans_b, alpha, op_a, op_b, beta, &c);
+      EXPECT_TRUE(s21_reference::Matches(c, gemm_expected, gemm_scale,
+                                         4 * (k + 2) * eps));
+    }
+  }
+}
+
+TEST(test_differential, elementwise_is_exact) {
+  std::mt19937 rng(7);
+  for (int iteration = 0; iteration < 100; iteration++) {
+    S21Matrix::SetCopyOnWrite(iteration % 2 == 0);
+    int m = 1 + rng() % 20, n = 1 + rng() % 20;
+    Dense a = RandomDense(rng, m, n, true), b = RandomDense(rng, m, n, true);
+    double number = RandomValue(rng, true);
+    S21Matrix left = a.ToMatrix(), right = b.ToMatrix();
+    EXPECT_TRUE(
+        s21_reference::Matches(left + right, s21_reference::Sum(a, b)));
+    EXPECT_TRUE(
+        s21_reference::Matches(left - right, s21_reference::Sub(a, b)));
+    EXPECT_TRUE(s21_reference::Matches(left * number,
+                                       s21_reference::MulNumber(a, number)));
+    EXPECT_TRUE(s21_reference::Matches(left.Transpose(),
+                                       s21_reference::Transpose(a)));
+    S21Matrix copy(left);
+    copy.SumMatrix(right);
+    EXPECT_TRUE(s21_reference::Matches(left, a));
+  }
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+// Determinant, complements, InverseMatrix and Solve of `a` against the
+// reference. The cofactor reference is exponential in the order, so from
+// n = 10 on only the determinant is compared.
+static void CompareSquare(const Dense& a, int kind) {
+  int n = a.rows;
+  S21Matrix matrix = a.ToMatrix();
+  double bound = HadamardBound(a);
+  double expected = s21_reference::Determinant(a);
+  EXPECT_NEAR(matrix.Determinant(), expected, 1e-11 * bound)
+      << "n " << n << " kind " << kind;
+  if (n > 9) return;
+
+  Dense complements = s21_reference::CalcComplements(a);
+  double complement_scale = 1;
+  for (double value : complements.values) {
+    complement_scale = std::max(complement_scale, std::fabs(value));
+  }
+  Dense scale(n, n);
+  for (double& value : scale.values) value = complement_scale;
+  EXPECT_TRUE(s21_reference::Matches(matrix.CalcComplements(), complements,
+                                     scale, 1e-10));
+
+  // Stay away from the 1e-6 singularity threshold, where either side
+  // may round across it, and from determinants that are rounding noise.
+  if (std::fabs(expected) > 1e-7 && std::fabs(expected) < 1e-5) return;
+  if (std::fabs(expected) <= 1e-11 * bound) return;
+  // The reference inverse is the adjugate over the determinant: built
+  // from the complements above rather than expanded a second time.
+  bool reference_throws = std::fabs(expected) < 1e-6, optimized_throws = false;
+  S21Matrix optimized;
+  try {
+    optimized = matrix.InverseMatrix();
+  } catch (const std::invalid_argument&) {
+    optimized_throws = true;
+  }
+  EXPECT_EQ(reference_throws, optimized_throws)
+      << "n " << n << " kind " << kind << " det " << expected;
+  if (reference_throws || optimized_throws) return;
+  Dense inverse = s21_reference::MulNumber(
+      s21_reference::Transpose(complements), 1 / expected);
+  double inverse_max = 0;
+  for (double value : inverse.values) {
+    inverse_max = std::max(inverse_max, std::fabs(value));
+  }
+  double condition = matrix.OneNorm() * optimized.OneNorm();
+  if (condition > 1e10) return;
+  for (double& value : scale.values) value = inverse_max * condition;
+  EXPECT_TRUE(s21_reference::Matches(optimized, inverse, scale, 1e-12))
+      << "n " << n << " kind " << kind;
+
+  Dense b(n, 2);
+  for (int i = 0; i < n; i++) {
+    b(i, 0) = 1;
+    b(i, 1) = i - 0.5 * n;
+  }
+  double b_max = 0.5 * n;
+  Dense solve_scale(n, 2);
+  for (double& value : solve_scale.values) {
+    value = n * inverse_max * b_max * condition;
+  }
+  EXPECT_TRUE(s21_reference::Matches(matrix.Solve(b.ToMatrix()),
+                                     s21_reference::Mul(inverse, b),
+                                     solve_scale, 1e-12))
+      << "n " << n << " kind " << kind;
+}
+
+TEST(test_differential, determinant_inverse_complements) {
+  std::mt19937 rng(99);
+  for (int iteration = 0; iteration < 240; iteration++) {
+    int n = 1 + rng() % 8;
+    int kind = iteration % 10;
+    CompareSquare(RandomSquare(rng, n, kind), kind);
+  }
+}
+
+// Past SmallLimit() the dispatch picks diagonal, triangular, banded,
+// Cholesky or LU kernels; every kind of RandomSquare is run through them.
+TEST(test_differential, structured_paths_match_reference) {
+  std::mt19937 rng(41);
+  for (int n : {9, 10}) {
+    for (int kind = 0; kind < 10; kind++) {
+      CompareSquare(RandomSquare(rng, n, kind), kind);
+    }
+  }
+}
+
+TEST(test_differential, power_and_reductions) {
+  std::mt19937 rng(5);
+  const double eps = std::numeric_limits<double>::epsilon();
+  for (int iteration = 0; iteration < 40; iteration++) {
+    int n = 1 + rng() % 12;
+    Dense a = RandomSquare(rng, n, 0);
+    a = s21_reference::MulNumber(a, 1.0 / (2 * n));
+    int k = 1 + rng() % 9;
+    Dense expected = a, scale = a;
+    for (double& value : scale.values) value = std::fabs(value);
+    for (int p = 1; p < k; p++) {
+      expected = s21_reference::Mul(expected, a);
+      scale = s21_reference::AbsMul(scale, a);
+    }
+    S21Matrix matrix = a.ToMatrix();
+    EXPECT_TRUE(s21_reference::Matches(matrix.Power(k), expected, scale,
+                                       4 * k * n * eps));
+
+    long double sum = 0, trace = 0, squares = 0;
+    for (int i = 0; i < n; i++) {
+      trace += a(i, i);
+      for (int j = 0; j < n; j++) {
+        sum += a(i, j);
+        squares += static_cast<long double>(a(i, j)) * a(i, j);
+      }
+    }
+    double magnitude = std::sqrt(static_cast<double>(squares)) * n;
+    EXPECT_NEAR(matrix.Sum(), static_cast<double>(sum), 4 * eps * magnitude);
+    EXPECT_NEAR(matrix.Trace(), static_cast<double>(trace),
+                4 * eps * magnitude);
+    EXPECT_NEAR(matrix.FrobeniusNorm(), std::sqrt(static_cast<double>(squares)),
+                4 * eps * magnitude);
+  }
+}
+
+TEST(test_small, fixed_kernels_match_reference) {
+  std::mt19937 rng(43);
+  for (int n = 1; n <= 9; n++) {
+    Dense a = RandomSquare(rng, n, 0), b = RandomSquare(rng, n, 0);
+    S21Matrix left = a.ToMatrix(), right = b.ToMatrix();
+    EXPECT_TRUE(s21_reference::Matches(left * right, s21_reference::Mul(a, b),
+                                       s21_reference::AbsMul(a, b),
+                                       4 * n * 1e-16));
+    EXPECT_TRUE(s21_reference::Matches(left.Transpose(),
+                                       s21_reference::Transpose(a)));
+    double expected = s21_reference::Determinant(a);
+    EXPECT_NEAR(left.Determinant(), expected, 1e-11 * HadamardBound(a));
+    S21Matrix product = left * left.InverseMatrix();
+    S21Matrix identity(n, n);
+    for (int i = 0; i < n; i++) identity(i, i) = 1;
+    EXPECT_TRUE(product.ApproxEqual(identity, S21Tolerance{1e-9, 1e-9}))
+        << "n " << n;
+  }
+}
+
+TEST(test_small, pivoting_and_singular) {
+  S21Matrix a(4, 4);
+  a(0, 1) = 2;
+  a(1, 0) = 3;
+  a(2, 3) = 4;
+  a(3, 2) = 5;
+  EXPECT_DOUBLE_EQ(a.Determinant(), 120);
+  S21Matrix inverse = a.InverseMatrix();
+  EXPECT_DOUBLE_EQ(inverse(1, 0), 0.5);
+  EXPECT_DOUBLE_EQ(inverse(3, 2), 0.25);
+  a(3, 2) = 0;
+  EXPECT_EQ(a.Determinant(), 0);
+  EXPECT_THROW(a.InverseMatrix(), std::invalid_argument);
+  S21Matrix tiny(2, 2);
+  tiny(0, 0) = tiny(1, 1) = 1e-4;
+  EXPECT_THROW(tiny.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(test_status, try_inverse_and_determinant) {
+  for (int n : {3, 10}) {
+    S21Matrix a = make_test_matrix(n), inverse;
+    EXPECT_EQ(a.TryInverse(&inverse), S21Status::kOk);
+    EXPECT_TRUE(inverse == a.InverseMatrix());
+    double determinant = 0;
+    EXPECT_EQ(a.TryDeterminant(&determinant), S21Status::kOk);
+    EXPECT_EQ(determinant, a.Determinant());
+
+    for (int j = 0; j < n; j++) a(n - 1, j) = a(0, j);
+    S21Matrix untouched(2, 2);
+    EXPECT_EQ(a.TryInverse(&untouched), S21Status::kSingular);
+    EXPECT_EQ(untouched.GetRows(), 2);
+  }
+  S21Matrix diagonal(12, 12);
+  for (int i = 0; i < 11; i++) diagonal(i, i) = 2;
+  S21Matrix result;
+  EXPECT_EQ(diagonal.TryInverse(&result), S21Status::kSingular);
+  EXPECT_EQ(S21Matrix(2, 3).TryInverse(&result),
+            S21Status::kInvalidMatrix);
+  EXPECT_EQ(diagonal.TryInverse(nullptr), S21Status::kInvalidMatrix);
+  double determinant = 0;
+  EXPECT_EQ(S21Matrix(2, 3).TryDeterminant(&determinant),
+            S21Status::kInvalidMatrix);
+}
+
+TEST(test_status, non_finite_inverse) {
+  for (double bad : {std::numeric_limits<double>::quiet_NaN(),
+                     std::numeric_limits<double>::infinity()}) {
+    S21Matrix a = make_test_matrix(12), result;
+    a(3, 4) = bad;
+    EXPECT_EQ(a.TryInverse(&result), S21Status::kSingular);
+    EXPECT_EQ(result.GetRows(), 1);
+    EXPECT_THROW(a.InverseMatrix(), std::invalid_argument);
+  }
+}
+
+TEST(test_status, try_solve) {
+  S21Matrix a = make_test_matrix(12), b(12, 3);
+  for (int i = 0; i < 12; i++) {
+    for (int j = 0; j < 3; j++) b(i, j) = i - j;
+  }
+  S21Matrix x;
+  EXPECT_EQ(a.TrySolve(b, &x), S21Status::kOk);
+  EXPECT_TRUE(a * x == b);
+  EXPECT_TRUE(a.Solve(b) == x);
+  S21Matrix aliased(b);
+  EXPECT_EQ(a.TrySolve(aliased, &aliased), S21Status::kOk);
+  EXPECT_TRUE(aliased == x);
+
+  EXPECT_EQ(a.TrySolve(S21Matrix(11, 1), &x), S21Status::kInvalidMatrix);
+  EXPECT_THROW(a.Solve(S21Matrix(11, 1)), std::invalid_argument);
+  for (int j = 0; j < 12; j++) a(5, j) = 0;
+  EXPECT_EQ(a.TrySolve(b, &x), S21Status::kSingular);
+  EXPECT_THROW(a.Solve(b), std::invalid_argument);
+}
+
+TEST(test_status, allocation_failure) {
+  // In a child whose address space cannot grow by the 72 MB the inverse
+  // needs, more than earlier tests can have left free in the heap.
+  pid_t child = fork();
+  if (child == 0) {
+    S21Matrix a = make_test_matrix(3000), inverse;
+    long pages = 0;
+    std::ifstream("/proc/self/statm") >> pages;
+    rlimit limit;
+    limit.rlim_cur = limit.rlim_max = pages * sysconf(_SC_PAGESIZE) + (4 << 20);
+    setrlimit(RLIMIT_AS, &limit);
+    bool reported = a.TryInverse(&inverse) == S21Status::kOutOfMemory;
+    double determinant = 0;
+    reported = reported && a.TryDeterminant(&determinant) ==
+                               S21Status::kOutOfMemory;
+    _exit(reported ? 0 : 1);
+  }
+  int status = 0;
+  waitpid(child, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+static S21Matrix make_spd_matrix(int n) {
+  S21Matrix b(n, n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) b(i, j) = std::sin(i * 5 + j * 2 + 1);
+  S21Matrix a = b * b.Transpose();
+  for (int i = 0; i < n; i++) {
+    a(i, i) += 1;
+    for (int j = 0; j < i; j++) a(j, i) = a(i, j);
+  }
+  return a;
+}
+
+TEST(test_cholesky, spd_inverse_is_exactly_symmetric) {
+  for (int n : {5, 40, 130}) {
+    S21Matrix a = make_spd_matrix(n), identity(n, n);
+    for (int i = 0; i < n; i++) identity(i, i) = 1;
+    S21Matrix inverse = a.InverseMatrix();
+    EXPECT_TRUE(inverse.ExactEqual(inverse.Transpose())) << "n " << n;
+    EXPECT_TRUE(inverse.ApproxEqual(a.Solve(identity), S21Tolerance{1e-9}));
+    EXPECT_TRUE((a * inverse).ApproxEqual(identity, S21Tolerance{1e-8}));
+  }
+}
+
+TEST(test_cholesky, indefinite_and_singular_fall_back) {
+  S21Matrix a = make_spd_matrix(9);
+  for (int i = 0; i < 9; i++) a(i, i) -= 20;
+  S21Matrix inverse = a.InverseMatrix(), identity(9, 9);
+  for (int i = 0; i < 9; i++) identity(i, i) = 1;
+  EXPECT_TRUE((a * inverse).ApproxEqual(identity, S21Tolerance{1e-8}));
+
+  S21Matrix rank_one(12, 12);
+  for (int i = 0; i < 12; i++)
+    for (int j = 0; j < 12; j++) rank_one(i, j) = (i + 1) * (j + 1);
+  EXPECT_EQ(rank_one.TryInverse(&inverse), S21Status::kSingular);
+  S21Matrix tiny = make_spd_matrix(10) * 1e-3;
+  EXPECT_EQ(tiny.TryInverse(&inverse), S21Status::kSingular);
+}
+
+TEST(test_tuning, save_load_and_validation) {
+  std::string path = "/tmp/s21-tuning-" + std::to_string(getpid());
+  S21TuningParameters custom;
+  custom.parallel_work = 1000;
+  custom.gemm_rows = 3;
+  custom.gemm_cols = 40;
+  custom.cholesky_block = 7;
+  custom.small_max = 2;
+  S21Tuning::Set(custom);
+  ASSERT_TRUE(S21Tuning::Save(path));
+  S21Tuning::Reset();
+  EXPECT_EQ(S21Tuning::Get().gemm_cols, S21TuningParameters().gemm_cols);
+  ASSERT_TRUE(S21Tuning::Load(path));
+  S21TuningParameters loaded = S21Tuning::Get();
+  EXPECT_EQ(loaded.parallel_work, 1000);
+  EXPECT_EQ(loaded.gemm_rows, 3);
+  EXPECT_EQ(loaded.gemm_cols, 40);
+  EXPECT_EQ(loaded.cholesky_block, 7);
+  EXPECT_EQ(loaded.small_max, 2);
+
+  std::ofstream(path) << "gemm_rows = 5\nsmall_max = 9\n";
+  EXPECT_FALSE(S21Tuning::Load(path));
+  std::ofstream(path) << "gemm_rows = five\n";
+  EXPECT_FALSE(S21Tuning::Load(path));
+  EXPECT_EQ(S21Tuning::Get().gemm_rows, 3);
+  std::ofstream(path) << "# comment\nunknown = 1\n gemm_cols = 64 # tail\n";
+  EXPECT_TRUE(S21Tuning::Load(path));
+  EXPECT_EQ(S21Tuning::Get().gemm_cols, 64);
+  std::remove(path.c_str());
+  EXPECT_FALSE(S21Tuning::Load(path));
+
+  custom.gemm_rows = 0;
+  EXPECT_THROW(S21Tuning::Set(custom), std::invalid_argument);
+  setenv("S21_TUNING_FILE", path.c_str(), 1);
+  EXPECT_EQ(S21Tuning::DefaultPath(), path);
+  unsetenv("S21_TUNING_FILE");
+  S21Tuning::Reset();
+}
+
+TEST(test_tuning, kernels_agree_under_any_parameters) {
+  S21Matrix a = make_test_matrix(37), b = make_test_matrix(37);
+  b.SetCols(29);
+  S21Matrix spd = make_spd_matrix(37), small = make_test_matrix(6);
+  S21Matrix product = a * b, inverse = spd.InverseMatrix();
+  S21Matrix small_inverse = small.InverseMatrix();
+  S21TuningParameters extreme;
+  extreme.parallel_work = 1;
+  extreme.gemm_rows = 1;
+  extreme.gemm_cols = 8;
+  extreme.cholesky_block = 1;
+  extreme.small_max = 0;
+  S21Tuning::Set(extreme);
+  EXPECT_TRUE(a * b == product);
+  EXPECT_TRUE(spd.InverseMatrix() == inverse);
+  EXPECT_TRUE(small.InverseMatrix() == small_inverse);
+  S21Tuning::Reset();
+
+  S21TuningParameters tuned = S21Tuning::Tune(32);
+  S21TuningParameters current = S21Tuning::Get();
+  EXPECT_EQ(tuned.gemm_cols, current.gemm_cols);
+  // Every column block candidate covers all 32 columns, like the default.
+  EXPECT_EQ(tuned.gemm_cols, S21TuningParameters().gemm_cols);
+  EXPECT_EQ(tuned.small_max, current.small_max);
+  EXPECT_THROW(S21Tuning::Tune(8), std::invalid_argument);
+  S21Tuning::Reset();
+}
+
+TEST(test_elementwise, kronecker) {
+  S21Matrix a(2, 2), b(2, 3), out(6, 6);
+  a(0, 0) = 1;
+  a(0, 1) = 2;
+  a(1, 0) = -1;
+  a(1, 1) = 0.5;
+  for (int k = 0; k < 2; k++)
+    for (int l = 0; l < 3; l++) b(k, l) = k * 3 + l + 1;
+  S21Elementwise::Kronecker(a, b, &out);
+  ASSERT_EQ(out.GetRows(), 4);
+  ASSERT_EQ(out.GetCols(), 6);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 6; j++)
+      EXPECT_EQ(out(i, j), a(i / 2, j / 3) * b(i % 2, j % 3));
+  S21Elementwise::Kronecker(a, b, &a);
+  EXPECT_TRUE(a.ExactEqual(out));
+}
+
+TEST(test_elementwise, hadamard_and_broadcast) {
+  S21Matrix a = make_test_matrix(5), b = make_test_matrix(5) * 2;
+  S21Matrix out(5, 5);
+  const double* storage = &out(0, 0);
+  S21Elementwise::HadamardMul(a, b, &out);
+  EXPECT_EQ(&out(0, 0), storage);
+  S21Matrix quotient;
+  S21Elementwise::HadamardDiv(out, b, &quotient);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_EQ(out(i, j), a(i, j) * b(i, j));
+      EXPECT_DOUBLE_EQ(quotient(i, j), a(i, j));
+    }
+  }
+  EXPECT_THROW(S21Elementwise::HadamardMul(a, S21Matrix(5, 4), &out),
+               std::invalid_argument);
+
+  S21Matrix row(1, 5), column(5, 1), sum, product;
+  for (int i = 0; i < 5; i++) {
+    row(0, i) = i;
+    column(i, 0) = 10 * i;
+  }
+  S21Elementwise::BroadcastAdd(a, row, &sum);
+  S21Elementwise::BroadcastMul(a, column, &product);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_EQ(sum(i, j), a(i, j) + j);
+      EXPECT_EQ(product(i, j), a(i, j) * 10 * i);
+    }
+  }
+  S21Elementwise::BroadcastAdd(a, column, &column);
+  EXPECT_EQ(column.GetCols(), 5);
+  EXPECT_EQ(column(3, 1), a(3, 1) + 30);
+  S21Elementwise::BroadcastAdd(a, a, &a);
+  EXPECT_TRUE(a == make_test_matrix(5) * 2);
+  EXPECT_THROW(S21Elementwise::BroadcastMul(a, S21Matrix(2, 5), &out),
+               std::invalid_argument);
+  EXPECT_THROW(S21Elementwise::BroadcastMul(a, row, nullptr),
+               std::invalid_argument);
+}
+
+TEST(test_elementwise, fused_map) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix a = make_test_matrix(300), shared(a), out;
+  double shift = 0.25;
+  auto fused = [shift](double x) {
+    return std::exp(-(x - shift) * (x - shift));
+  };
+  S21Elementwise::Map(a, fused, &out);
+  for (int i = 0; i < 300; i += 7)
+    for (int j = 0; j < 300; j += 11) EXPECT_EQ(out(i, j), fused(a(i, j)));
+  S21Elementwise::Map(a, [](double x) { return -x; }, &a);
+  EXPECT_EQ(a(4, 9), -shared(4, 9));
+  EXPECT_TRUE(shared == make_test_matrix(300));
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+TEST(test_distributed, summa_matches_serial_product) {
+  S21Matrix a = make_test_matrix(13), b = make_test_matrix(11);
+  a.SetCols(11);
+  b.SetCols(9);
+  S21Matrix expected = a * b;
+  for (int processes : {1, 3, 4}) {
+    EXPECT_TRUE(S21SocketTransport::RunForked(
+        processes, [&](S21Transport& transport) {
+          auto da = S21DistributedMatrix::Scatter(transport, a, 3);
+          auto db = S21DistributedMatrix::Scatter(transport, b, 3);
+          S21Matrix product = da.MulMatrix(db).Gather();
+          if (transport.GetRank() == 0 && !product.ApproxEqual(expected)) {
+            throw std::runtime_error("wrong product");
+          }
+        }));
+  }
+}
+
+TEST(test_distributed, lu_factors_and_determinant) {
+  S21Matrix a = make_test_matrix(13);
+  for (int j = 0; j < 13; j++) a(12, j) = -4 * a(3, j);
+  a(12, 12) += 0.5;
+  EXPECT_TRUE(S21SocketTransport::RunForked(4, [&](S21Transport& transport) {
+    auto distributed = S21DistributedMatrix::Scatter(transport, a, 3);
+    if (distributed.GetGridRows() != 2) throw std::runtime_error("grid");
+    distributed.LuFactor();
+    S21Matrix lu = distributed.Gather();
+    if (transport.GetRank() != 0) return;
+    S21Matrix lower(13, 13), upper(13, 13), permuted(a);
+    for (int i = 0; i < 13; i++) {
+      for (int j = 0; j < 13; j++) {
+        (j < i ? lower : upper)(i, j) = lu(i, j);
+      }
+      lower(i, i) = 1;
+      int pivot = distributed.GetPivots()[i];
+      for (int j = 0; j < 13; j++) {
+        std::swap(permuted(i, j), permuted(pivot, j));
+      }
+    }
+    if (!(lower * upper).ApproxEqual(permuted)) throw std::runtime_error("lu");
+  }));
+
+  S21Matrix small = make_test_matrix(6), singular = small;
+  for (int j = 0; j < 6; j++) singular(5, j) = singular(1, j) * 2;
+  double expected = small.Determinant();
+  EXPECT_TRUE(S21SocketTransport::RunForked(3, [&](S21Transport& transport) {
+    auto regular = S21DistributedMatrix::Scatter(transport, small, 2, 0, 3);
+    double determinant = regular.LuFactor();
+    if (std::fabs(determinant - expected) > 1e-9 * std::fabs(expected)) {
+      throw std::runtime_error("determinant");
+    }
+    auto zero = S21DistributedMatrix::Scatter(transport, singular, 2);
+    if (std::fabs(zero.LuFactor()) > 1e-9 * std::fabs(expected)) {
+      throw std::runtime_error("singular determinant");
+    }
+  }));
+
+  // Three blocks over four processes: with a 1 x 4 grid the last rank owns
+  // no columns, with a 4 x 1 grid no rows.
+  S21Matrix uneven = make_test_matrix(5);
+  double uneven_expected = uneven.Determinant();
+  EXPECT_TRUE(S21SocketTransport::RunForked(4, [&](S21Transport& transport) {
+    for (int grid_rows : {1, 4}) {
+      auto distributed =
+          S21DistributedMatrix::Scatter(transport, uneven, 2, 0, grid_rows);
+      double determinant = distributed.LuFactor();
+      if (std::fabs(determinant - uneven_expected) >
+          1e-9 * std::fabs(uneven_expected)) {
+        throw std::runtime_error("uneven determinant");
+      }
+    }
+  }));
+}
+
+TEST(test_distributed, errors_and_failing_ranks) {
+  EXPECT_FALSE(S21SocketTransport::RunForked(2, [](S21Transport& transport) {
+    if (transport.GetRank() == 1) throw std::runtime_error("rank 1 failed");
+    double value;
+    transport.Receive(1, &value, sizeof(value));
+  }));
+  EXPECT_THROW(S21SocketTransport::RunForked(0, [](S21Transport&) {}),
+               std::invalid_argument);
+  EXPECT_TRUE(S21SocketTransport::RunForked(2, [](S21Transport& transport) {
+    S21DistributedMatrix a(transport, 4, 5, 2), b(transport, 4, 5, 2);
+    bool threw = false;
+    try {
+      a.MulMatrix(b);
+    } catch (const std::invalid_argument&) {
+      threw = true;
+    }
+    if (!threw) throw std::runtime_error("mul shape");
+    try {
+      a.LuFactor();
+      threw = false;
+    } catch (const std::invalid_argument&) {
+    }
+    if (!threw) throw std::runtime_error("lu shape");
+  }));
+}
+
+TEST(test_distributed, rendezvous_by_socket_path) {
+  std::string directory = "/tmp/s21-test-" + std::to_string(getpid());
+  ASSERT_EQ(mkdir(directory.c_str(), 0700), 0);
+  S21Matrix a = make_test_matrix(7), expected = a * a;
+  pid_t child = fork();
+  if (child == 0) {
+    try {
+      S21SocketTransport transport(1, 2, directory);
+      auto da = S21DistributedMatrix::Scatter(transport, a, 2);
+      da.MulMatrix(da).Gather();
+    } catch (...) {
+      _exit(1);
+    }
+    _exit(0);
+  }
+  S21SocketTransport transport(0, 2, directory);
+  auto da = S21DistributedMatrix::Scatter(transport, a, 2);
+  EXPECT_TRUE(da.MulMatrix(da).Gather().ApproxEqual(expected));
+  int status = 0;
+  waitpid(child, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  rmdir(directory.c_str());
+}
+
 int main(int argc, char *argv[]) {
+  // Drop the host's tuning file, loaded before main, so that results do
+  // not depend on the machine the tests run on.
+  S21Tuning::Reset();
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,24 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "s21_tuning.h"
+
+// Tunes the kernels for this host and stores the result where every
+// program linked with the library loads it at startup.
+// Usage: tune [n] [path]
+int main(int argc, char* argv[]) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 256;
+  std::string path = argc > 2 ? argv[2] : S21Tuning::DefaultPath();
+  S21TuningParameters parameters = S21Tuning::Tune(n);
+  std::printf("parallel_work  %ld\n", parameters.parallel_work);
+  std::printf("gemm_rows      %d\n", parameters.gemm_rows);
+  std::printf("gemm_cols      %d\n", parameters.gemm_cols);
+  std::printf("cholesky_block %d\n", parameters.cholesky_block);
+  std::printf("small_max      %d\n", parameters.small_max);
+  if (!S21Tuning::Save(path)) {
+    std::fprintf(stderr, "cannot write %s\n", path.c_str());
+    return 1;
+  }
+  std::printf("saved to %s\n", path.c_str());
+  return 0;
+}